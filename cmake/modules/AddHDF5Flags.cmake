@@ -0,0 +1,29 @@
+# SPDX-FileCopyrightText: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+# SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+# Module providing convenience methods for compile binaries with HDF5 support.
+#
+# .. cmake_function:: add_dune_hdf5_flags
+#
+#    .. cmake_param:: targets
+#       :multi:
+#       :required:
+#       :positional:
+#
+#       The targets to add the HDF5 flags to.
+#
+#    Collective parallel output requires an HDF5 library built with MPI support.
+#
+
+# set HAVE_HDF5 for config.h
+set(HAVE_HDF5 ${HDF5_FOUND})
+
+function(add_dune_hdf5_flags)
+  if(HDF5_FOUND)
+    foreach(_target ${ARGN})
+      target_include_directories(${_target} PUBLIC ${HDF5_C_INCLUDE_DIRS})
+      target_link_libraries(${_target} PUBLIC ${HDF5_C_LIBRARIES})
+      target_compile_definitions(${_target} PUBLIC ${HDF5_C_DEFINITIONS} ENABLE_HDF5=1)
+    endforeach(_target)
+  endif(HDF5_FOUND)
+endfunction(add_dune_hdf5_flags)
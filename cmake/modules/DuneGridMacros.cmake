@@ -23,6 +23,11 @@ include(AddAlbertaFlags)
 set_package_properties(Alberta PROPERTIES TYPE OPTIONAL
   PURPOSE "Provides the grid manager AlbertaGrid and file reader AlbertaReader")
 
+find_package(HDF5 COMPONENTS C)
+include(AddHDF5Flags)
+set_package_properties(HDF5 PROPERTIES TYPE OPTIONAL
+  PURPOSE "Provides the single-file VTKHDF writer")
+
 set(DEFAULT_DGF_GRIDDIM 1)
 set(DEFAULT_DGF_WORLDDIM 1)
 set(DEFAULT_DGF_GRIDTYPE ONEDGRID)
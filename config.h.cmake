@@ -48,6 +48,10 @@
    application uses the ALBERTA_CPPFLAGS */
 #cmakedefine HAVE_ALBERTA ENABLE_ALBERTA
 
+/* This is only true if HDF5 was found by configure _and_ if the
+   application uses the HDF5 flags (add_dune_hdf5_flags) */
+#cmakedefine HAVE_HDF5 ENABLE_HDF5
+
 /* Define to 1 if you have mkstemp function */
 #cmakedefine01 HAVE_MKSTEMP
 
@@ -596,6 +596,11 @@ namespace Dune
     Alberta::CoordCache< dimension > coordCache_;
 #endif
 
+#if DUNE_ALBERTA_CACHE_LEAF_ELEMENTS
+    // flat lists of the leaf entities, filled by the first leaf traversal after a mesh change
+    mutable AlbertaLeafCache< dim, dimworld > leafCache_;
+#endif
+
     // current state of adaptation
     AdaptationState adaptationState_;
   };
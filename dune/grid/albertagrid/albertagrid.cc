@@ -178,6 +178,10 @@ namespace Dune
       delete leafIndexSet_;
     leafIndexSet_ = 0;
 
+#if DUNE_ALBERTA_CACHE_LEAF_ELEMENTS
+    leafCache_.clear();
+#endif
+
     // release dof vectors
     hIndexSet_.release();
     levelProvider_.release();
@@ -260,12 +264,28 @@ namespace Dune
   {
     typedef AlbertaGridLeafIterator< codim, pitype, const This > LeafIteratorImp;
 
+#if DUNE_ALBERTA_CACHE_LEAF_ELEMENTS
+    // all leaf entities are iterated through flat lists, filled by the first traversal after a mesh change
+    if( !leafCache_.up2Date( codim ) )
+    {
+      if( codim == 0 )
+      {
+        typedef AlbertaGridLeafIterator< 0, All_Partition, const This > TreeIteratorImp;
+        const LeafIterator begin( TreeIteratorImp( *this, static_cast< const MarkerVector * >( nullptr ), maxlevel_ ) );
+        leafCache_.template build< 0 >( begin, LeafIterator( TreeIteratorImp( *this, maxlevel_ ) ), dofNumbering_ );
+      }
+      else
+        leafCache_.template build< codim >( leafbegin< 0 >(), leafend< 0 >(), dofNumbering_ );
+    }
+    return LeafIteratorImp( *this, leafCache_.records( codim ), maxlevel_ );
+#else
     MarkerVector &markerVector = leafMarkerVector_;
     const int firstMarkedCodim = 2;
     if( (codim >= firstMarkedCodim) && !markerVector.up2Date() )
       markerVector.template markSubEntities< firstMarkedCodim >( leafbegin< 0 >(), leafend< 0 >() );
 
     return LeafIteratorImp( *this, &markerVector, maxlevel_ );
+#endif
   }
 
 
@@ -557,6 +577,11 @@ namespace Dune
     // unset up2Dat status, if leafbegin is called then this status is updated
     leafMarkerVector_.clear();
 
+#if DUNE_ALBERTA_CACHE_LEAF_ELEMENTS
+    // the leaf entities are cached again by the next leaf traversal
+    leafCache_.clear();
+#endif
+
     sizeCache_.reset();
 
     // update index sets (if they exist)
@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_ALBERTA_LEAFCACHE_HH
+#define DUNE_ALBERTA_LEAFCACHE_HH
+
+#include <array>
+#include <cassert>
+#include <vector>
+
+#include <dune/grid/albertagrid/dofadmin.hh>
+#include <dune/grid/albertagrid/elementinfo.hh>
+
+#if HAVE_ALBERTA
+
+namespace Dune
+{
+
+  // AlbertaLeafCache
+  // ----------------
+
+  /** \class   AlbertaLeafCache
+   *  \ingroup AlbertaGrid
+   *  \brief   flat lists of the leaf entities of an AlbertaGrid
+   *
+   *  For each codimension, the list is filled by one traversal of the leaf
+   *  elements and is then used by the leaf iterators instead of descending the
+   *  refinement trees again. Each record holds a reference to the ElementInfo,
+   *  i.e., the ALBERTA EL_INFO (element pointer, level, element type, neighbor
+   *  and boundary information) stays available without refilling it from the
+   *  father.
+   *
+   *  A subentity is recorded once, on the element with the largest index
+   *  containing it (the element AlbertaMarkerVector would assign it to).
+   *
+   *  The cache has to be cleared whenever the mesh changes. As every record
+   *  keeps an EL_INFO alive, it is only used if DUNE_ALBERTA_CACHE_LEAF_ELEMENTS
+   *  is set.
+   */
+  template< int dim, int dimworld >
+  class AlbertaLeafCache
+  {
+    typedef AlbertaLeafCache< dim, dimworld > This;
+
+  public:
+    static const int dimension = dim;
+
+    typedef Alberta::ElementInfo< dimension > ElementInfo;
+    typedef Alberta::HierarchyDofNumbering< dimension > DofNumbering;
+
+    //! entity visited by the leaf iterator
+    struct Record
+    {
+      ElementInfo elementInfo;
+      int subEntity;
+    };
+
+    typedef std::vector< Record > Records;
+
+    AlbertaLeafCache ()
+    {
+      up2Date_.fill( false );
+    }
+
+    //! return true if the leaf entities of given codimension are cached
+    bool up2Date ( int codim ) const
+    {
+      return up2Date_[ codim ];
+    }
+
+    //! obtain the cached leaf entities of given codimension
+    const Records &records ( int codim ) const
+    {
+      assert( up2Date( codim ) );
+      return records_[ codim ];
+    }
+
+    //! fill the cache for one codimension from a range of leaf elements
+    template< int codim, class Iterator >
+    void build ( const Iterator &begin, const Iterator &end, const DofNumbering &dofNumbering );
+
+    void clear ()
+    {
+      for( int codim = 0; codim <= dimension; ++codim )
+      {
+        Records().swap( records_[ codim ] );
+        up2Date_[ codim ] = false;
+      }
+    }
+
+  private:
+    std::array< Records, dimension+1 > records_;
+    std::array< bool, dimension+1 > up2Date_;
+  };
+
+
+
+  // Implementation of AlbertaLeafCache
+  // ----------------------------------
+
+  template< int dim, int dimworld >
+  template< int codim, class Iterator >
+  inline void AlbertaLeafCache< dim, dimworld >
+  ::build ( const Iterator &begin, const Iterator &end, const DofNumbering &dofNumbering )
+  {
+    static const int numSubEntities = Alberta::NumSubEntities< dimension, codim >::value;
+
+    Records &records = records_[ codim ];
+    records.clear();
+
+    if( codim == 0 )
+    {
+      for( Iterator it = begin; it != end; ++it )
+        records.push_back( Record{ it->impl().elementInfo(), 0 } );
+    }
+    else
+    {
+      // position of each subentity in the list and index of the element it is recorded on
+      const int size = dofNumbering.size( codim );
+      std::vector< int > position( size, -1 ), owner( size, -1 );
+
+      for( Iterator it = begin; it != end; ++it )
+      {
+        const ElementInfo &elementInfo = it->impl().elementInfo();
+        const int index = dofNumbering( elementInfo, 0, 0 );
+        for( int i = 0; i < numSubEntities; ++i )
+        {
+          const int subIndex = dofNumbering( elementInfo, codim, i );
+          if( position[ subIndex ] < 0 )
+          {
+            position[ subIndex ] = static_cast< int >( records.size() );
+            records.push_back( Record{ elementInfo, i } );
+          }
+          else if( index > owner[ subIndex ] )
+            records[ position[ subIndex ] ] = Record{ elementInfo, i };
+          else
+            continue;
+          owner[ subIndex ] = index;
+        }
+      }
+    }
+
+    records.shrink_to_fit();
+    up2Date_[ codim ] = true;
+  }
+
+} // namespace Dune
+
+#endif // #if HAVE_ALBERTA
+
+#endif // #ifndef DUNE_ALBERTA_LEAFCACHE_HH
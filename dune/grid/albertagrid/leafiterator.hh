@@ -27,6 +27,7 @@ namespace Dune
   public:
     typedef typename Base::Entity Entity;
     typedef typename Base::MarkerVector MarkerVector;
+    typedef typename Base::LeafCache LeafCache;
 
     AlbertaGridLeafIterator ()
     {}
@@ -43,6 +44,13 @@ namespace Dune
       : Base( grid, vec, level )
     {}
 
+    //! Constructor making begin iterator traversing cached leaf entities
+    AlbertaGridLeafIterator ( const GridImp &grid,
+                              const typename LeafCache::Records &records,
+                              int level )
+      : Base( grid, records, level )
+    {}
+
     //! increment the iterator
     void increment ()
     {
@@ -61,6 +69,7 @@ namespace Dune
   public:
     typedef typename Base::Entity Entity;
     typedef typename Base::MarkerVector MarkerVector;
+    typedef typename Base::LeafCache LeafCache;
 
      AlbertaGridLeafIterator ()
     {}
@@ -77,6 +86,13 @@ namespace Dune
       : Base( grid, level )
     {}
 
+    //! Constructor making begin iterator (which is the end iterator in this case)
+    AlbertaGridLeafIterator ( const GridImp &grid,
+                              const typename LeafCache::Records &,
+                              int level )
+      : Base( grid, level )
+    {}
+
     //! increment the iterator
     void increment ()
     {
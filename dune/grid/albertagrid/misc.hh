@@ -21,6 +21,11 @@
 #define DUNE_ALBERTA_CACHE_COORDINATES 1
 #endif
 
+// should the leaf entities be cached in flat lists (trades memory for faster leaf iteration)?
+#ifndef DUNE_ALBERTA_CACHE_LEAF_ELEMENTS
+#define DUNE_ALBERTA_CACHE_LEAF_ELEMENTS 0
+#endif
+
 namespace Dune
 {
 
@@ -12,6 +12,7 @@
 #include <dune/common/typetraits.hh>
 
 #include <dune/grid/albertagrid/elementinfo.hh>
+#include <dune/grid/albertagrid/leafcache.hh>
 #include <dune/grid/albertagrid/meshpointer.hh>
 
 #if HAVE_ALBERTA
@@ -210,6 +211,7 @@ namespace Dune
     typedef typename EntityImp::ElementInfo ElementInfo;
 
     typedef AlbertaMarkerVector< dimension, dimensionworld > MarkerVector;
+    typedef AlbertaLeafCache< dimension, dimensionworld > LeafCache;
 
     AlbertaGridTreeIterator ();
 
@@ -227,6 +229,11 @@ namespace Dune
                               const MarkerVector *marker,
                               int travLevel );
 
+    //! Constructor making begin iterator traversing cached leaf entities
+    AlbertaGridTreeIterator ( const GridImp &grid,
+                              const typename LeafCache::Records &records,
+                              int travLevel );
+
     //! equality
     bool equals ( const This &other ) const
     {
@@ -281,6 +288,10 @@ namespace Dune
 
     // knows on which element a point,edge,face is viewed
     const MarkerVector *marker_;
+
+    // current and end position in the cached entities (null if not traversing the cache)
+    const typename LeafCache::Record *record_;
+    const typename LeafCache::Record *recordEnd_;
   };
 
 
@@ -344,7 +355,9 @@ namespace Dune
       level_( -1 ),
       subEntity_( -1 ),
       macroIterator_(),
-      marker_( NULL )
+      marker_( NULL ),
+      record_( nullptr ),
+      recordEnd_( nullptr )
   {}
 
   template< int codim, class GridImp, bool leafIterator >
@@ -356,7 +369,9 @@ namespace Dune
       level_( travLevel ),
       subEntity_( (codim == 0 ? 0 : -1) ),
       macroIterator_( grid.meshPointer().begin() ),
-      marker_( marker )
+      marker_( marker ),
+      record_( nullptr ),
+      recordEnd_( nullptr )
   {
     ElementInfo elementInfo = *macroIterator_;
     nextElementStop( elementInfo );
@@ -376,10 +391,34 @@ namespace Dune
       level_( travLevel ),
       subEntity_( -1 ),
       macroIterator_( grid.meshPointer().end() ),
-      marker_( 0 )
+      marker_( 0 ),
+      record_( nullptr ),
+      recordEnd_( nullptr )
   {}
 
 
+  template< int codim, class GridImp, bool leafIterator >
+  inline AlbertaGridTreeIterator< codim, GridImp, leafIterator >
+  ::AlbertaGridTreeIterator ( const GridImp &grid,
+                              const typename LeafCache::Records &records,
+                              int travLevel )
+    : entity_( EntityImp( grid ) ),
+      level_( travLevel ),
+      subEntity_( -1 ),
+      macroIterator_( grid.meshPointer().end() ),
+      marker_( 0 ),
+      record_( records.data() ),
+      recordEnd_( records.data() + records.size() )
+  {
+    static_assert( leafIterator, "Only leaf entities are cached." );
+    if( record_ != recordEnd_ )
+    {
+      subEntity_ = record_->subEntity;
+      entity_.impl().setElement( record_->elementInfo, subEntity_ );
+    }
+  }
+
+
   // Make LevelIterator with point to element from previous iterations
   template< int codim, class GridImp, bool leafIterator >
   inline AlbertaGridTreeIterator< codim, GridImp, leafIterator >
@@ -388,7 +427,9 @@ namespace Dune
       level_( other.level_ ),
       subEntity_( other.subEntity_ ),
       macroIterator_( other.macroIterator_ ),
-      marker_( other.marker_ )
+      marker_( other.marker_ ),
+      record_( other.record_ ),
+      recordEnd_( other.recordEnd_ )
   {}
 
 
@@ -402,6 +443,8 @@ namespace Dune
     subEntity_ =  other.subEntity_;
     macroIterator_ = other.macroIterator_;
     marker_ = other.marker_;
+    record_ = other.record_;
+    recordEnd_ = other.recordEnd_;
 
     return *this;
   }
@@ -410,6 +453,21 @@ namespace Dune
   template< int codim, class GridImp, bool leafIterator >
   inline void AlbertaGridTreeIterator< codim, GridImp, leafIterator >::increment ()
   {
+    if( record_ )
+    {
+      if( ++record_ != recordEnd_ )
+      {
+        subEntity_ = record_->subEntity;
+        entity_.impl().setElement( record_->elementInfo, subEntity_ );
+      }
+      else
+      {
+        subEntity_ = -1;
+        entity_.impl().setElement( ElementInfo(), subEntity_ );
+      }
+      return;
+    }
+
     ElementInfo elementInfo = entity_.impl().elementInfo_;
     goNext ( elementInfo );
     // it is ok to set the invalid ElementInfo
@@ -70,7 +70,25 @@ namespace Dune
         typename HostGrid::Traits::LevelIndexSet::Types,
         typename HostGrid::Traits::LeafIndexSet::IndexType,
         typename HostGrid::Traits::LeafIndexSet::Types
-        > Traits;
+        > BaseTraits;
+
+    /** \brief The traits of the IdentityGrid
+
+       The geometries of an IdentityGrid are those of the host grid.  Instead of wrapping
+       them into IdentityGridGeometry objects, the host geometry types are used directly.
+       Stacked IdentityGrids thus have the geometry types of the innermost grid.
+     */
+    struct Traits
+      : public BaseTraits
+    {
+      template<int cd>
+      struct Codim
+        : public BaseTraits::template Codim<cd>
+      {
+        typedef typename HostGrid::template Codim<cd>::Geometry Geometry;
+        typedef typename HostGrid::template Codim<cd>::LocalGeometry LocalGeometry;
+      };
+    };
 
   };
 
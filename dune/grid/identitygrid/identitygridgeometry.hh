@@ -7,6 +7,9 @@
 
 /** \file
  * \brief The IdentityGridGeometry class and its specializations
+ *
+ * \note IdentityGrid uses the geometry types of its host grid directly.  This wrapper
+ *       is only kept for code instantiating it explicitly.
  */
 
 #include <dune/common/fmatrix.hh>
@@ -5,9 +5,15 @@
 #ifndef DUNE_GRID_IO_FILE_GMSHWRITER_HH
 #define DUNE_GRID_IO_FILE_GMSHWRITER_HH
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <limits>
+#include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -16,6 +22,7 @@
 #include <dune/geometry/referenceelements.hh>
 #include <dune/grid/common/grid.hh>
 #include <dune/grid/common/mcmgmapper.hh>
+#include <dune/grid/utility/globalindexset.hh>
 
 namespace Dune {
 
@@ -24,7 +31,8 @@ namespace Dune {
 
      \brief Write Gmsh mesh file
 
-     Write a grid using the given GridView as an ASCII Gmsh file of version 2.0.
+     Write a grid using the given GridView as an ASCII Gmsh file of version 2.0
+     (write()) or as a binary Gmsh file of version 4.1 (writeBinary()).
 
      If the grid contains an element type not supported by gmsh an IOError exception is thrown.
 
@@ -178,6 +186,60 @@ namespace Dune {
       }
     }
 
+    /** \brief Dune number of the k-th corner of an element in Gmsh numbering
+     *
+     * Quadrilaterals, hexahedra and pyramids number their corners differently than Dune.
+     */
+    static int duneCorner(std::size_t element_type, int k) {
+      static const int quadrilateral[] = { 0, 1, 3, 2 };
+      static const int hexahedron[] = { 0, 1, 3, 2, 4, 5, 7, 6 };
+      static const int pyramid[] = { 0, 1, 3, 2, 4 };
+      switch (element_type) {
+      case 3 : return quadrilateral[k];
+      case 5 : return hexahedron[k];
+      case 7 : return pyramid[k];
+      default : return k;
+      }
+    }
+
+    //! append the binary representation of a value to a buffer
+    template<class T>
+    static void append(std::vector<char>& buffer, const T& value) {
+      const char* bytes = reinterpret_cast<const char*>(&value);
+      buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    //! write a binary section enclosed by its begin and end markers
+    static void writeSection(std::ofstream& file, const std::string& section, const std::vector<char>& buffer) {
+      file << "$" << section << "\n";
+      file.write(buffer.data(), buffer.size());
+      file << "\n$End" << section << "\n";
+    }
+
+    /** \brief Appends the description of an entity following its tag in the $Entities or
+     *         $PartitionedEntities format: coordinates (points) or bounding box, the physical
+     *         tag (none if physical is 0) and no bounding entities.
+     */
+    static void appendEntity(std::vector<char>& buffer, int entityDim, int physical,
+                             const std::array<double, 6>& box) {
+      for (int j = 0; j < (entityDim == 0 ? 3 : 6); ++j)
+        append(buffer, box[j]);
+      append(buffer, std::uint64_t(physical > 0 ? 1 : 0));
+      if (physical > 0)
+        append(buffer, std::int32_t(physical));
+      if (entityDim > 0)
+        append(buffer, std::uint64_t(0));
+    }
+
+    //! name of the file of a partition: mesh.msh becomes mesh_1.msh for the first process
+    static std::string partitionFileName(const std::string& fileName, int rank) {
+      const std::string suffix = "_" + std::to_string(rank+1);
+      const std::size_t dot = fileName.rfind(".msh");
+      if ((dot != std::string::npos) && (dot + 4 == fileName.size()))
+        return fileName.substr(0, dot) + suffix + ".msh";
+      return fileName + suffix;
+    }
+
   public:
     /**
      * \brief Constructor expecting GridView of Grid to be written.
@@ -255,6 +317,250 @@ namespace Dune {
       file << "$EndElements" << std::endl;
     }
 
+    /**
+     * \brief Write given grid as a binary Gmsh 4.1 file.
+     * \param fileName Path of file. This method does not attach a ".msh"-extension by itself.
+     * \param physicalEntities Physical entities for each element (optional).
+     * \param physicalBoundaries Physical boundaries (optional).
+     *
+     * Nodes and elements are assembled in memory, the elements grouped in blocks by entity and
+     * element type, and each section is written with a single call. Nodes are numbered by the
+     * index set, elements by the element mapper, both starting with 1; the boundaries follow
+     * the elements.
+     *
+     * Each distinct physical entity and physical boundary value forms a Gmsh entity with this
+     * tag and physical tag. The value 0 stands for no physical tag, like in the files read by
+     * GmshReader, and is given the next free entity tag.
+     *
+     * In parallel, each process writes the interior elements of its partition into a file of
+     * its own, the name being extended by the partition number (mesh.msh becomes mesh_1.msh,
+     * mesh_2.msh, ...). A $PartitionedEntities section describes the partition, nodes and
+     * elements are numbered consistently over all processes. This method has to be called on
+     * all processes then.
+     *
+     * Throws an IOError if file could not be opened or an unsupported element type is
+     * encountered.
+     *
+     * \returns the name of the file written by this process
+     */
+    std::string writeBinary(const std::string& fileName,
+                            const std::vector<int>& physicalEntities=std::vector<int>(),
+                            const std::vector<int>& physicalBoundaries=std::vector<int>()) const {
+      const auto& comm = gv.comm();
+      const bool partitioned = (comm.size() > 1);
+      const auto& indexSet = gv.indexSet();
+
+      // node and element tags, numbered over all processes in parallel
+      std::vector<std::uint64_t> nodeTag(gv.size(dim)), elementTag(gv.size(0));
+      MultipleCodimMultipleGeomTypeMapper<GridView> elementMapper(gv, mcmgElementLayout());
+      if (partitioned) {
+        GlobalIndexSet<GridView> globalNodes(gv, dim), globalElements(gv, 0);
+        for (const auto& vertex : vertices(gv))
+          nodeTag[indexSet.index(vertex)] = globalNodes.index(vertex) + 1;
+        for (const auto& entity : elements(gv))
+          elementTag[elementMapper.index(entity)] = globalElements.index(entity) + 1;
+      }
+      else {
+        for (std::size_t i = 0; i < nodeTag.size(); ++i)
+          nodeTag[i] = i + 1;
+        for (std::size_t i = 0; i < elementTag.size(); ++i)
+          elementTag[i] = i + 1;
+      }
+
+      // the boundaries are numbered after all elements, in the order of the processes
+      std::uint64_t numElements = 0, numBoundaries = 0;
+      for (const auto& entity : elements(gv, Partitions::interior)) {
+        ++numElements;
+        if (!physicalBoundaries.empty())
+          for (const auto& intersection : intersections(gv, entity))
+            numBoundaries += intersection.boundary();
+      }
+      std::uint64_t boundaryTag = comm.sum(numElements) + 1;
+      if (partitioned) {
+        std::vector<std::uint64_t> boundaries(comm.size());
+        comm.allgather(&numBoundaries, 1, boundaries.data());
+        for (int p = 0; p < comm.rank(); ++p)
+          boundaryTag += boundaries[p];
+      }
+
+      // entity tags are the physical values, 0 (no physical tag) gets the next free tag;
+      // partitioned entities are shifted per process
+      auto physicalTag = [] (int value) {
+        if (value < 0)
+          DUNE_THROW(Dune::IOError, "Gmsh physical tags cannot be negative, got " << value);
+        return value;
+      };
+      std::array<int, 2> maxTag = {{ 0, 0 }};
+      for (int value : physicalEntities)
+        maxTag[0] = std::max(maxTag[0], physicalTag(value));
+      for (int value : physicalBoundaries)
+        maxTag[1] = std::max(maxTag[1], physicalTag(value));
+      if (partitioned)
+        comm.max(maxTag.data(), 2);
+      auto modelTag = [&] (int codim, int physical) {
+        return physical > 0 ? physical : maxTag[codim] + 1;
+      };
+      auto entityTag = [&] (int codim, int physical) {
+        return modelTag(codim, physical) + (partitioned ? (maxTag[codim] + 1) * (comm.rank() + 1) : 0);
+      };
+
+      // element blocks by entity dimension, entity tag and element type
+      std::map<std::array<int, 3>, std::pair<std::uint64_t, std::vector<std::uint64_t> > > blocks;
+      std::set<std::pair<int, int> > entities;
+      std::vector<bool> used(nodeTag.size(), false);
+      for (const auto& entity : elements(gv, Partitions::interior)) {
+        const std::size_t element_type = translateDuneToGmshType(entity.type());
+        const int physical = physicalEntities.empty() ? 0 : physicalEntities[elementMapper.index(entity)];
+        entities.insert({ int(dim), physical });
+
+        auto& block = blocks[{{ int(dim), entityTag(0, physical), int(element_type) }}];
+        ++block.first;
+        block.second.push_back(elementTag[elementMapper.index(entity)]);
+        const int corners = entity.subEntities(dim);
+        for (int k = 0; k < corners; ++k) {
+          const auto index = indexSet.subIndex(entity, duneCorner(element_type, k), dim);
+          block.second.push_back(nodeTag[index]);
+          used[index] = true;
+        }
+
+        if (!physicalBoundaries.empty()) {
+          auto refElement = referenceElement<typename GridView::ctype,dim>(entity.type());
+          for (const auto& intersection : intersections(gv, entity)) {
+            if (!intersection.boundary())
+              continue;
+            const std::size_t face_type = translateDuneToGmshType(intersection.type());
+            const int physical = physicalBoundaries[intersection.boundarySegmentIndex()];
+            entities.insert({ int(dim)-1, physical });
+
+            auto& faceBlock = blocks[{{ int(dim)-1, entityTag(1, physical), int(face_type) }}];
+            ++faceBlock.first;
+            faceBlock.second.push_back(boundaryTag++);
+            const int faceCorners = refElement.size(intersection.indexInInside(), 1, dim);
+            for (int k = 0; k < faceCorners; ++k)
+              faceBlock.second.push_back(nodeTag[indexSet.subIndex(entity, refElement.subEntity(intersection.indexInInside(), 1, duneCorner(face_type, k), dim), dim)]);
+          }
+        }
+      }
+
+      // nodes with their coordinates, all in one block of the first element entity
+      std::vector<std::uint64_t> nodes;
+      std::vector<double> coordinates;
+      std::array<double, 6> box = {{ 0, 0, 0, 0, 0, 0 }};
+      for (int j = 0; j < 3; ++j) {
+        box[j] = (dimWorld > unsigned(j) ? std::numeric_limits<double>::max() : 0.0);
+        box[j+3] = (dimWorld > unsigned(j) ? std::numeric_limits<double>::lowest() : 0.0);
+      }
+      for (const auto& vertex : vertices(gv)) {
+        const auto index = indexSet.index(vertex);
+        if (!used[index])
+          continue;
+        nodes.push_back(nodeTag[index]);
+        const auto globalCoord = vertex.geometry().center();
+        for (unsigned int j = 0; j < 3; ++j) {
+          const double x = (j < dimWorld ? double(globalCoord[j]) : 0.0);
+          coordinates.push_back(x);
+          box[j] = std::min(box[j], x);
+          box[j+3] = std::max(box[j+3], x);
+        }
+      }
+      std::array<double, 6> globalBox = box;
+      if (partitioned) {
+        comm.min(globalBox.data(), 3);
+        comm.max(globalBox.data() + 3, 3);
+      }
+
+      const std::string name = partitioned ? partitionFileName(fileName, comm.rank()) : fileName;
+      std::ofstream file(name.c_str(), std::ios::binary);
+      if (!file.is_open())
+        DUNE_THROW(Dune::IOError, "Could not open " << name << " with write access.");
+
+      // Output Header; the binary data starts with the integer 1 to detect the byte order
+      file << "$MeshFormat\n" << "4.1 1 " << sizeof(std::uint64_t) << "\n";
+      const std::int32_t one = 1;
+      file.write(reinterpret_cast<const char*>(&one), sizeof(one));
+      file << "\n$EndMeshFormat\n";
+
+      // Output Entities
+      std::array<std::uint64_t, 4> numEntities = {{ 0, 0, 0, 0 }};
+      for (const auto& entity : entities)
+        ++numEntities[entity.first];
+      std::vector<char> buffer;
+      for (std::uint64_t count : numEntities)
+        append(buffer, count);
+      for (const auto& entity : entities) {
+        append(buffer, std::int32_t(modelTag(int(dim) - entity.first, entity.second)));
+        appendEntity(buffer, entity.first, entity.second, globalBox);
+      }
+      writeSection(file, "Entities", buffer);
+
+      if (partitioned) {
+        buffer.clear();
+        append(buffer, std::uint64_t(comm.size()));
+        append(buffer, std::uint64_t(0)); // no ghost entities
+        for (std::uint64_t count : numEntities)
+          append(buffer, count);
+        for (const auto& entity : entities) {
+          const int codim = int(dim) - entity.first;
+          append(buffer, std::int32_t(entityTag(codim, entity.second)));
+          append(buffer, std::int32_t(entity.first));
+          append(buffer, std::int32_t(modelTag(codim, entity.second)));
+          append(buffer, std::uint64_t(1));
+          append(buffer, std::int32_t(comm.rank() + 1));
+          appendEntity(buffer, entity.first, entity.second, box);
+        }
+        writeSection(file, "PartitionedEntities", buffer);
+      }
+
+      // Output Nodes
+      buffer.clear();
+      const auto nodeRange = std::minmax_element(nodes.begin(), nodes.end());
+      append(buffer, std::uint64_t(nodes.empty() ? 0 : 1));
+      append(buffer, std::uint64_t(nodes.size()));
+      append(buffer, nodes.empty() ? std::uint64_t(0) : *nodeRange.first);
+      append(buffer, nodes.empty() ? std::uint64_t(0) : *nodeRange.second);
+      if (!nodes.empty()) {
+        const auto elementBlock = blocks.lower_bound({{ int(dim), std::numeric_limits<int>::min(), 0 }});
+        append(buffer, std::int32_t(dim));
+        append(buffer, std::int32_t(elementBlock->first[1]));
+        append(buffer, std::int32_t(0)); // not parametric
+        append(buffer, std::uint64_t(nodes.size()));
+        const char* tags = reinterpret_cast<const char*>(nodes.data());
+        buffer.insert(buffer.end(), tags, tags + nodes.size() * sizeof(std::uint64_t));
+        const char* coords = reinterpret_cast<const char*>(coordinates.data());
+        buffer.insert(buffer.end(), coords, coords + coordinates.size() * sizeof(double));
+      }
+      writeSection(file, "Nodes", buffer);
+
+      // Output Elements
+      buffer.clear();
+      std::uint64_t total = 0, minTag = std::numeric_limits<std::uint64_t>::max(), maxTagElement = 0;
+      for (const auto& block : blocks) {
+        total += block.second.first;
+        const std::size_t stride = block.second.second.size() / block.second.first;
+        for (std::size_t i = 0; i < block.second.second.size(); i += stride) {
+          minTag = std::min(minTag, block.second.second[i]);
+          maxTagElement = std::max(maxTagElement, block.second.second[i]);
+        }
+      }
+      append(buffer, std::uint64_t(blocks.size()));
+      append(buffer, total);
+      append(buffer, total > 0 ? minTag : std::uint64_t(0));
+      append(buffer, maxTagElement);
+      for (const auto& block : blocks) {
+        append(buffer, std::int32_t(block.first[0]));
+        append(buffer, std::int32_t(block.first[1]));
+        append(buffer, std::int32_t(block.first[2]));
+        append(buffer, block.second.first);
+        const char* data = reinterpret_cast<const char*>(block.second.second.data());
+        buffer.insert(buffer.end(), data, data + block.second.second.size() * sizeof(std::uint64_t));
+      }
+      writeSection(file, "Elements", buffer);
+
+      if (!file)
+        DUNE_THROW(Dune::IOError, "Could not write " << name << ".");
+      return name;
+    }
+
   };
 
 } // namespace Dune
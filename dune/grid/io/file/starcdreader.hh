@@ -5,13 +5,22 @@
 #ifndef DUNE_STARCD_READER_HH
 #define DUNE_STARCD_READER_HH
 
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
 #include <dune/common/exceptions.hh>
 
 #include <dune/geometry/type.hh>
 #include <dune/grid/common/gridfactory.hh>
-#include <iostream>
-#include <fstream>
-#include <memory>
 
 namespace Dune {
 
@@ -51,6 +60,74 @@ namespace Dune {
   template <class GridType>
   class StarCDReader {
 
+    // splits a file read into memory into numbers separated by white space
+    class Tokenizer
+    {
+    public:
+      Tokenizer(const std::string& fileName)
+        : fileName_(fileName)
+      {
+        std::ifstream file(fileName.c_str(), std::ios::binary);
+        if (!file)
+          DUNE_THROW(Dune::IOError, "Could not open " << fileName);
+        file.seekg(0, std::ios::end);
+        buffer_.resize(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0, std::ios::beg);
+        file.read(buffer_.data(), buffer_.size());
+        if (!file)
+          DUNE_THROW(Dune::IOError, "Could not read " << fileName);
+        pos_ = buffer_.data();
+        end_ = buffer_.data() + buffer_.size();
+      }
+
+      //! skip white space and return true if another number follows
+      bool next ()
+      {
+        while ((pos_ != end_) && std::isspace(static_cast<unsigned char>(*pos_)))
+          ++pos_;
+        return (pos_ != end_);
+      }
+
+      //! read the next number
+      template<class T>
+      T read ()
+      {
+        next();
+        T value = 0;
+        const char* last = parse(value);
+        if (last == pos_)
+          DUNE_THROW(Dune::IOError, "Could not parse a number in " << fileName_ << " at position " << (pos_ - buffer_.data()));
+        pos_ = last;
+        return value;
+      }
+
+    private:
+      template<class T>
+      const char* parse (T& value) const
+      {
+        const auto result = std::from_chars(pos_, end_, value);
+        return (result.ec == std::errc() ? result.ptr : pos_);
+      }
+
+      const char* parse (double& value) const
+      {
+#if __cpp_lib_to_chars >= 201611L
+        const auto result = std::from_chars(pos_, end_, value);
+        return (result.ec == std::errc() ? result.ptr : pos_);
+#else
+        // the buffer of std::string is null terminated
+        char* last = nullptr;
+        value = std::strtod(pos_, &last);
+        return last;
+#endif
+      }
+
+      std::string fileName_;
+      std::string buffer_;
+      const char* pos_ = nullptr;
+      const char* end_ = nullptr;
+    };
+
   public:
 
     /** \brief Read grid from a Star-CD file
@@ -58,6 +135,8 @@ namespace Dune {
      *    \param fileName The base file name of the Star-CD files
      *    \param verbose Tlag to set whether information should be printed
      *
+     * Each file is read into memory at once and parsed without streams.
+     *
      * \return The return type is a special pointer type that casts into
      *    std::unique_ptr<GridType>, and std::shared_ptr<GridType>.  It is scheduled
      *    to be replaced by std::unique_ptr<GridType> eventually.
@@ -75,56 +154,50 @@ namespace Dune {
       // set up the grid factory
       GridFactory<GridType> factory;
 
-      // set the name of the vertex file
-      std::string vertexFileName = fileName + ".vrt";
-
-      // set the vertex input stream
-      std::ifstream vertexFile(vertexFileName.c_str());
-      if (!vertexFile)
-        DUNE_THROW(Dune::IOError, "Could not open " << vertexFileName);
-
       // read the vertices
-      int dummyIdx;
       int numberOfVertices = 0;
-      while (vertexFile >> dummyIdx) {
-        numberOfVertices++;
-
+      {
+        Tokenizer vertexFile(fileName + ".vrt");
         Dune::FieldVector<double,dim> position;
+        while (vertexFile.next()) {
+          vertexFile.template read<long>();
+          numberOfVertices++;
 
-        for (int k = 0; k < dim; k++)
-          vertexFile >> position[k];
+          for (int k = 0; k < dim; k++)
+            position[k] = vertexFile.template read<double>();
 
-        factory.insertVertex(position);
+          factory.insertVertex(position);
+        }
       }
       if (verbose)
         std::cout << numberOfVertices << " vertices read." << std::endl;
 
-      // set the name of the element file
-      std::string elementFileName = fileName + ".cel";
-
-      // set the element input stream
-      std::ifstream elementFile(elementFileName.c_str());
-      if (!elementFile)
-        DUNE_THROW(Dune::IOError, "Could not open " << elementFileName);
-
       // read the elements
+      Tokenizer elementFile(fileName + ".cel");
       int numberOfElements = 0;
       int numberOfSimplices = 0;
       int numberOfPyramids = 0;
       int numberOfPrisms = 0;
-      int numberOfCubes = 0;;
-      int maxNumberOfVertices = (int)pow(2, dim);
-      int isVolume = 1;
-      while (elementFile >> dummyIdx) {
-        std::vector<unsigned int> vertices(maxNumberOfVertices);
-        for (int k = 0; k < maxNumberOfVertices; k++)
-          elementFile >> vertices[k];
+      int numberOfCubes = 0;
+      const int isVolume = 1;
+
+      // the vertex lists are allocated once and reused for all elements
+      std::array<unsigned int, 8> vertices;
+      std::vector<unsigned int> simplexVertices(4);
+      std::vector<unsigned int> pyramidVertices(5);
+      std::vector<unsigned int> prismVertices(6);
+      std::vector<unsigned int> cubeVertices(8);
+      while (elementFile.next()) {
+        elementFile.template read<long>();
+        for (int k = 0; k < 8; k++)
+          vertices[k] = elementFile.template read<unsigned int>();
 
-        int boundaryId;
-        elementFile >> boundaryId;
+        // boundary id
+        elementFile.template read<int>();
 
         int volumeOrSurface[2];
-        elementFile >> volumeOrSurface[0] >> volumeOrSurface[1];
+        volumeOrSurface[0] = elementFile.template read<int>();
+        volumeOrSurface[1] = elementFile.template read<int>();
 
         if (volumeOrSurface[0] == isVolume) {
           numberOfElements++;
@@ -132,7 +205,6 @@ namespace Dune {
           if (vertices[2] == vertices[3]) {           // simplex or prism
             if (vertices[4] == vertices[5]) {             // simplex
               numberOfSimplices++;
-              std::vector<unsigned int> simplexVertices(4);
               for (int k = 0; k < 3; k++)
                 simplexVertices[k] = vertices[k] - 1;
               simplexVertices[3] = vertices[4] - 1;
@@ -140,7 +212,6 @@ namespace Dune {
             }
             else {             // prism
               numberOfPrisms++;
-              std::vector<unsigned int> prismVertices(6);
               for (int k = 0; k < 3; k++)
                 prismVertices[k] = vertices[k] - 1;
               for (int k = 3; k < 6; k++)
@@ -151,14 +222,12 @@ namespace Dune {
           else {           // cube or pyramid
             if (vertices[4] == vertices[5]) {             // pyramid
               numberOfPyramids++;
-              std::vector<unsigned int> pyramidVertices(5);
               for (int k = 0; k < 5; k++)
                 pyramidVertices[k] = vertices[k] - 1;
               factory.insertElement(Dune::GeometryTypes::pyramid, pyramidVertices);
             }
             else {             // cube
               numberOfCubes++;
-              std::vector<unsigned int> cubeVertices(8);
               for (int k = 0; k < 8; k++)
                 cubeVertices[k] = vertices[k] - 1;
               std::swap(cubeVertices[2], cubeVertices[3]);
@@ -5,8 +5,15 @@
 
 #include "config.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <string>
 #include <tuple>
@@ -41,6 +48,7 @@
 #include <dune/grid/io/file/vtk/vtkwriter.hh>
 #include <dune/grid/io/file/gmshreader.hh>
 #include <dune/grid/io/file/gmshwriter.hh>
+#include <dune/grid/utility/globalindexset.hh>
 
 using namespace Dune;
 
@@ -55,6 +63,134 @@ struct EnableLevelIntersectionIteratorCheck< Dune::AlbertaGrid< dim, dimworld >
 template<class T>
 T &discarded(T &&v) { return v; }
 
+// number of nodes of a Gmsh element type, boundary faces included
+int gmshNodes(std::int32_t type)
+{
+  switch (type) {
+  case 1: return 2;
+  case 2: return 3;
+  case 3: return 4;
+  case 4: return 4;
+  case 5: return 8;
+  case 6: return 6;
+  case 7: return 5;
+  case 15: return 1;
+  default: DUNE_THROW(Dune::IOError, "unexpected Gmsh element type " << type);
+  }
+}
+
+/* check a binary Gmsh 4.1 file written by GmshWriter::writeBinary() for the interior elements
+ * of a grid view: the header, the number of nodes and elements, that all node tags of the
+ * elements are defined, and the node tags and coordinates of the first interior element
+ */
+template<class GridView, class NodeTag>
+void checkBinaryGmsh(const GridView& gridView, const std::string& fileName, NodeTag nodeTag,
+                     std::uint64_t numBoundaries = 0)
+{
+  constexpr int dim = GridView::dimension;
+
+  std::ifstream file(fileName, std::ios::binary);
+  std::string line;
+  std::getline(file, line);
+  std::getline(file, line);
+  if (line != "4.1 1 8")
+    DUNE_THROW(Dune::IOError, fileName << ": unexpected format '" << line << "'");
+  std::int32_t one = 0;
+  file.read(reinterpret_cast<char*>(&one), sizeof(one));
+  if (one != 1)
+    DUNE_THROW(Dune::IOError, fileName << ": wrong byte order mark");
+
+  auto read = [&] (auto& value) {
+    file.read(reinterpret_cast<char*>(&value), sizeof(value));
+    if (!file)
+      DUNE_THROW(Dune::IOError, fileName << ": unexpected end of file");
+    return value;
+  };
+  // the section header: number of blocks, number of nodes or elements, minimum and maximum tag
+  auto section = [&] (const std::string& name) {
+    while (std::getline(file, line) && (line != "$" + name)) {}
+    std::array<std::uint64_t, 4> header;
+    if (!file)
+      DUNE_THROW(Dune::IOError, fileName << ": section " << name << " missing");
+    for (auto& value : header)
+      read(value);
+    return header;
+  };
+
+  std::map<std::uint64_t, std::array<double, 3> > nodes;
+  const auto nodeHeader = section("Nodes");
+  for (std::uint64_t block = 0; block < nodeHeader[0]; ++block) {
+    std::array<std::int32_t, 3> entity;
+    std::uint64_t size = 0;
+    for (auto& value : entity)
+      read(value);
+    std::vector<std::uint64_t> tags(read(size));
+    for (auto& tag : tags)
+      read(tag);
+    for (auto tag : tags)
+      for (auto& x : nodes[tag])
+        read(x);
+  }
+
+  std::vector<std::vector<std::uint64_t> > elements;
+  const auto elementHeader = section("Elements");
+  std::uint64_t numElements = 0;
+  for (std::uint64_t block = 0; block < elementHeader[0]; ++block) {
+    std::array<std::int32_t, 3> entity;
+    std::uint64_t size = 0;
+    for (auto& value : entity)
+      read(value);
+    read(size);
+    numElements += size;
+    for (std::uint64_t i = 0; i < size; ++i) {
+      std::uint64_t tag = 0;
+      std::vector<std::uint64_t> element(gmshNodes(entity[2]));
+      read(tag);
+      for (auto& node : element)
+        if (nodes.count(read(node)) == 0)
+          DUNE_THROW(Dune::IOError, fileName << ": element " << tag << " has undefined node " << node);
+      if (entity[0] == dim)
+        elements.push_back(element);
+    }
+  }
+
+  // the file holds the interior elements and the nodes they use
+  std::set<std::size_t> usedVertices;
+  std::uint64_t numInterior = 0;
+  for (const auto& element : Dune::elements(gridView, Partitions::interior)) {
+    ++numInterior;
+    for (unsigned int i = 0; i < element.subEntities(dim); ++i)
+      usedVertices.insert(gridView.indexSet().subIndex(element, i, dim));
+  }
+  if ((nodeHeader[1] != usedVertices.size()) || (nodes.size() != usedVertices.size()))
+    DUNE_THROW(Dune::IOError, fileName << ": wrong number of nodes");
+  if ((elementHeader[1] != numInterior + numBoundaries) || (numElements != elementHeader[1]))
+    DUNE_THROW(Dune::IOError, fileName << ": wrong number of elements");
+  if (numInterior == 0)
+    return;
+
+  // find the first interior element by its node tags and compare the coordinates
+  const auto first = *Dune::elements(gridView, Partitions::interior).begin();
+  std::vector<std::uint64_t> expected;
+  for (unsigned int i = 0; i < first.subEntities(dim); ++i)
+    expected.push_back(nodeTag(first.template subEntity<dim>(i)));
+  std::sort(expected.begin(), expected.end());
+  const bool found = std::any_of(elements.begin(), elements.end(), [&] (auto element) {
+    std::sort(element.begin(), element.end());
+    return element == expected;
+  });
+  if (!found)
+    DUNE_THROW(Dune::IOError, fileName << ": first interior element not found");
+  for (unsigned int i = 0; i < first.subEntities(dim); ++i) {
+    const auto vertex = first.template subEntity<dim>(i);
+    const auto x = vertex.geometry().center();
+    const auto& y = nodes[nodeTag(vertex)];
+    for (int j = 0; j < 3; ++j)
+      if (std::abs((j < int(x.size()) ? double(x[j]) : 0.0) - y[j]) > 1e-12)
+        DUNE_THROW(Dune::IOError, fileName << ": wrong coordinates of node " << nodeTag(vertex));
+  }
+}
+
 template<class Grid, class... Args>
 using read_gf_result_t =
   decltype(GmshReader<Grid>::read(std::declval<GridFactory<Grid>&>(),
@@ -114,6 +250,21 @@ void testReadingAndWritingGrid( const std::string& path, const std::string& grid
     writer.write(outputNameBoundary,elementsIDs,boundaryIDs);
   }
 
+  // Write binary MSH 4.1
+  auto nodeTag = [&] (const auto& vertex) { return leafGridView.indexSet().index(vertex) + 1; };
+  const std::string outputNameBinary(gridName+"-"+gridManagerName+"-gmshtest-write-binary.msh");
+  checkBinaryGmsh(leafGridView, writer.writeBinary(outputNameBinary), nodeTag);
+  if((!boundaryIDs.empty())&&(!elementsIDs.empty()))
+  {
+    std::size_t numBoundaries = 0;
+    for(const auto& entity:elements(leafGridView))
+      for(const auto& intersection:intersections(leafGridView,entity))
+        numBoundaries += intersection.boundary();
+    const std::string outputNameBinaryBoundary(gridName+"-"+gridManagerName+"-gmshtest-write-binary-boundary.msh");
+    checkBinaryGmsh(leafGridView, writer.writeBinary(outputNameBinaryBoundary,elementsIDs,boundaryIDs),
+                    nodeTag, numBoundaries);
+  }
+
   // Write VTK
   std::ostringstream vtkName;
   vtkName << gridName << "-gmshtest-" << refinements;
@@ -257,15 +408,39 @@ void testReadingAndWritingGrid( const std::string& path, const std::string& grid
   }
 }
 
+// write a distributed grid as binary MSH 4.1, one file per process with globally numbered nodes
+template <typename GridType>
+void testWritingBinaryGridParallel( const std::string& path, const std::string& gridName,
+                                    const std::string& gridManagerName )
+{
+  std::shared_ptr<GridType> grid = GmshReader<GridType>::read(path+gridName+".msh");
+  grid->loadBalance();
+  const auto leafGridView(grid->leafGridView());
+
+  GlobalIndexSet<typename GridType::LeafGridView> globalNodes(leafGridView, GridType::dimension);
+  auto nodeTag = [&] (const auto& vertex) { return globalNodes.index(vertex) + 1; };
+  Dune::GmshWriter<typename GridType::LeafGridView> writer( leafGridView );
+  const std::string outputName(gridName+"-"+gridManagerName+"-gmshtest-write-binary-parallel.msh");
+  checkBinaryGmsh(leafGridView, writer.writeBinary(outputName), nodeTag);
+}
 
 int main( int argc, char** argv )
 try
 {
-  MPIHelper::instance( argc, argv );
+  [[maybe_unused]] const MPIHelper& mpiHelper = MPIHelper::instance( argc, argv );
   const int refinements = ( argc > 1 ) ? atoi( argv[1] ) : 0;
   const std::string path(static_cast<std::string>(DUNE_GRID_EXAMPLE_GRIDS_PATH)+"gmsh/");
 
 #if GMSH_UGGRID
+  if (mpiHelper.size() > 1)
+  {
+    // the other tests read and write the same files on all processes
+    testWritingBinaryGridParallel<UGGrid<2> >( path, "unitsquare_quads_2x2", "UGGrid-2D" );
+    testWritingBinaryGridParallel<UGGrid<2> >( path, "hybrid-testgrid-2d", "UGGrid-2D" );
+    testWritingBinaryGridParallel<UGGrid<3> >( path, "hybrid-testgrid-3d", "UGGrid-3D" );
+    return 0;
+  }
+
   testReadingAndWritingGrid<UGGrid<2> >( path, "curved2d", "UGGrid-2D", refinements );
   testReadingAndWritingGrid<UGGrid<2> >( path, "circle2ndorder", "UGGrid-2D", refinements );
   testReadingAndWritingGrid<UGGrid<2> >( path, "unitsquare_quads_2x2", "UGGrid-2D", refinements );
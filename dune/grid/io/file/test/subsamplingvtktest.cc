@@ -118,6 +118,14 @@ int doWrite( Dune::VTKChecker& vtkChecker, const std::string& gridViewName,
   name = vtk.write(prefix.str() + "-appendedraw", Dune::VTK::appendedraw);
   if(rank == 0) vtkChecker.push(name);
 
+  // the second file reuses the subsampled topology of the first one
+  vtk.reuseTopology();
+  name = vtk.write(prefix.str() + "-reuse-appendedraw", Dune::VTK::appendedraw);
+  if(rank == 0) vtkChecker.push(name);
+
+  name = vtk.write(prefix.str() + "-reuse-base64", Dune::VTK::base64);
+  if(rank == 0) vtkChecker.push(name);
+
   return result;
 }
 
@@ -0,0 +1,206 @@
+// SPDX-FileCopyrightText: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#include "config.h"
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/yaspgrid.hh>
+#if HAVE_DUNE_UGGRID
+#include <dune/grid/uggrid.hh>
+#include <dune/grid/utility/structuredgridfactory.hh>
+#endif
+#include <dune/grid/io/file/vtk/vtkhdfwriter.hh>
+
+/* Write a VTKHDF file with and without time steps and check the sizes of the
+ * arrays written by all processes.
+ */
+
+// read a one dimensional integer data set
+std::vector<std::int64_t> readInt64 (hid_t location, const std::string& name)
+{
+  Dune::VTK::HDF5Handle dataSet(H5Dopen2(location, name.c_str(), H5P_DEFAULT), H5Dclose, "opening " + name);
+  Dune::VTK::HDF5Handle space(H5Dget_space(dataSet), H5Sclose, "obtaining data space");
+  std::vector<std::int64_t> values(H5Sget_simple_extent_npoints(space));
+  Dune::VTK::checkHDF5(H5Dread(dataSet, H5T_NATIVE_INT64, H5S_ALL, H5S_ALL, H5P_DEFAULT, values.data()), "reading " + name);
+  return values;
+}
+
+// return the number of rows of a data set
+hsize_t rows (hid_t location, const std::string& name)
+{
+  Dune::VTK::HDF5Handle dataSet(H5Dopen2(location, name.c_str(), H5P_DEFAULT), H5Dclose, "opening " + name);
+  Dune::VTK::HDF5Handle space(H5Dget_space(dataSet), H5Sclose, "obtaining data space");
+  hsize_t dims[2] = {0, 0};
+  H5Sget_simple_extent_dims(space, dims, nullptr);
+  return dims[0];
+}
+
+std::int64_t sum (const std::vector<std::int64_t>& values, std::size_t begin, std::size_t end)
+{
+  std::int64_t s = 0;
+  for (std::size_t i = begin; i < end; ++i)
+    s += values[i];
+  return s;
+}
+
+template<class GridView>
+int checkFile (const GridView& gridView, const std::string& fileName, int steps, int grids)
+{
+  int result = 0;
+  const std::size_t parts = gridView.comm().size();
+  std::int64_t cells = 0;
+  for ([[maybe_unused]] const auto& element : elements(gridView, Dune::Partitions::interior))
+    ++cells;
+  cells = gridView.comm().sum(cells);
+
+  Dune::VTK::HDF5Handle file(H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT), H5Fclose, "opening " + fileName);
+  Dune::VTK::HDF5Handle root(H5Gopen2(file, "VTKHDF", H5P_DEFAULT), H5Gclose, "opening group VTKHDF");
+
+  const auto numberOfCells = readInt64(root, "NumberOfCells");
+  const auto numberOfPoints = readInt64(root, "NumberOfPoints");
+  const auto numberOfIds = readInt64(root, "NumberOfConnectivityIds");
+  if (numberOfCells.size() != parts*grids)
+  {
+    std::cerr << fileName << ": wrong number of parts " << numberOfCells.size() << std::endl;
+    return 1;
+  }
+
+  // the interior cells of all processes form the grid
+  if (sum(numberOfCells, parts*(grids-1), parts*grids) != cells)
+  {
+    std::cerr << fileName << ": wrong number of cells" << std::endl;
+    result = 1;
+  }
+
+  const std::size_t allCells = sum(numberOfCells, 0, numberOfCells.size());
+  if ((rows(root, "Types") != allCells) || (rows(root, "Offsets") != allCells + parts*grids)
+      || (rows(root, "Points") != std::size_t(sum(numberOfPoints, 0, numberOfPoints.size())))
+      || (rows(root, "Connectivity") != std::size_t(sum(numberOfIds, 0, numberOfIds.size()))))
+  {
+    std::cerr << fileName << ": inconsistent grid arrays" << std::endl;
+    result = 1;
+  }
+
+  if ((rows(root, "CellData/cellData") != allCells*steps/grids)
+      || (rows(root, "PointData/vertexData") != std::size_t(sum(numberOfPoints, 0, numberOfPoints.size()))*steps/grids))
+  {
+    std::cerr << fileName << ": wrong size of data arrays" << std::endl;
+    result = 1;
+  }
+
+  if (steps > 1)
+  {
+    Dune::VTK::HDF5Handle stepsGroup(H5Gopen2(root, "Steps", H5P_DEFAULT), H5Gclose, "opening group Steps");
+    const auto pointOffsets = readInt64(stepsGroup, "PointOffsets");
+    const auto dataOffsets = readInt64(stepsGroup, "CellDataOffsets/cellData");
+    if ((pointOffsets.size() != std::size_t(steps)) || (dataOffsets.size() != std::size_t(steps)))
+    {
+      std::cerr << fileName << ": wrong number of steps" << std::endl;
+      result = 1;
+    }
+    else if ((grids == 1) && ((pointOffsets[1] != 0) || (dataOffsets[1] != std::int64_t(allCells/grids))))
+    {
+      std::cerr << fileName << ": the grid was not reused" << std::endl;
+      result = 1;
+    }
+    else if ((grids == steps) && (pointOffsets[1] == 0))
+    {
+      std::cerr << fileName << ": the changed grid was not written" << std::endl;
+      result = 1;
+    }
+  }
+
+  return result;
+}
+
+int main (int argc, char** argv)
+try
+{
+  const auto& mpiHelper = Dune::MPIHelper::instance(argc, argv);
+  const std::string suffix = "-np" + std::to_string(mpiHelper.size());
+
+  Dune::YaspGrid<2> grid(Dune::FieldVector<double,2>(1.0), {8, 8});
+  typedef Dune::YaspGrid<2>::LeafGridView GridView;
+  const GridView gridView = grid.leafGridView();
+
+  std::vector<double> cellData(gridView.size(0), 1.0);
+  std::vector<double> vertexData(gridView.size(2), 2.0);
+
+  int result = 0;
+
+  // single data set
+  {
+    Dune::VTKHDFWriter<GridView> writer(gridView);
+    writer.addCellData(cellData, "cellData");
+    writer.addVertexData(vertexData, "vertexData");
+    const std::string fileName = writer.write("vtkhdftest" + suffix);
+    result += checkFile(gridView, fileName, 1, 1);
+  }
+
+  // time series on a static grid
+  {
+    Dune::VTKHDFWriter<GridView> writer(gridView, Dune::VTK::nonconforming);
+    writer.reuseTopology();
+    writer.addCellData(cellData, "cellData");
+    writer.addVertexData(vertexData, "vertexData");
+    std::string fileName;
+    for (int step = 0; step < 3; ++step)
+      fileName = writer.writeTimeStep("vtkhdftest-series" + suffix, 0.1*step);
+    result += checkFile(gridView, fileName, 3, 1);
+  }
+
+#if HAVE_DUNE_UGGRID
+  // time series on a grid refined on the first process only, so the other processes
+  // have to write the grid again although their part did not change
+  {
+    typedef Dune::UGGrid<2> AdaptiveGrid;
+    auto adaptiveGrid = Dune::StructuredGridFactory<AdaptiveGrid>::createCubeGrid({0.0, 0.0}, {1.0, 1.0}, {8, 8});
+    adaptiveGrid->loadBalance();
+    typedef AdaptiveGrid::LeafGridView AdaptiveGridView;
+    const AdaptiveGridView adaptiveGridView = adaptiveGrid->leafGridView();
+
+    std::vector<double> adaptiveCellData(adaptiveGridView.size(0), 1.0);
+    std::vector<double> adaptiveVertexData(adaptiveGridView.size(2), 2.0);
+
+    Dune::VTKHDFWriter<AdaptiveGridView> writer(adaptiveGridView, Dune::VTK::nonconforming);
+    writer.reuseTopology();
+    writer.addCellData(adaptiveCellData, "cellData");
+    writer.addVertexData(adaptiveVertexData, "vertexData");
+    writer.writeTimeStep("vtkhdftest-adaptive" + suffix, 0.0);
+
+    // refine a single interior element on the first process
+    if (mpiHelper.rank() == 0)
+      for (const auto& element : elements(adaptiveGridView, Dune::Partitions::interior))
+      {
+        adaptiveGrid->mark(1, element);
+        break;
+      }
+    adaptiveGrid->preAdapt();
+    adaptiveGrid->adapt();
+    adaptiveGrid->postAdapt();
+
+    adaptiveCellData.assign(adaptiveGridView.size(0), 1.0);
+    adaptiveVertexData.assign(adaptiveGridView.size(2), 2.0);
+    const std::string fileName = writer.writeTimeStep("vtkhdftest-adaptive" + suffix, 0.1);
+    result += checkFile(adaptiveGridView, fileName, 2, 2);
+  }
+#endif
+
+  return result;
+}
+catch (Dune::Exception& e)
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
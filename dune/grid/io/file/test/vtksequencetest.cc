@@ -8,6 +8,8 @@
 #include <memory>
 #include <vector>
 #include <fstream>
+#include <iomanip>
+#include <sstream>
 #include <string>
 #include <unistd.h>
 
@@ -36,6 +38,26 @@ void checkFileEqualNumLines(const std::string& name1, const std::string& name2)
     DUNE_THROW(Dune::Exception, "Not the same number of lines (comparing " << name1 << " and " << name2 << ")");
 }
 
+// check that the files are identical
+void checkFilesEqual(const std::string& name1, const std::string& name2)
+{
+  std::ifstream file1(name1);
+  std::ifstream file2(name2);
+
+  if (file1.fail())
+    DUNE_THROW(Dune::Exception, "File " << name1 << " could not be opened!");
+
+  if (file2.fail())
+    DUNE_THROW(Dune::Exception, "File " << name2 << " could not be opened!");
+
+  std::stringstream content1, content2;
+  content1 << file1.rdbuf();
+  content2 << file2.rdbuf();
+
+  if (content1.str() != content2.str())
+    DUNE_THROW(Dune::Exception, "Files " << name1 << " and " << name2 << " differ");
+}
+
 std::string VTKDataMode(Dune::VTK::DataMode dm)
 {
   switch(dm)
@@ -140,6 +162,46 @@ std::string doWrite( const GridView &gridView, Dune::VTK::DataMode dm,
   return name.str();
 }
 
+// write a sequence with and without reusing the topology, refining the grid in between
+template< class Grid >
+void checkReuseTopology( Grid &grid, Dune::VTK::DataMode dm, Dune::VTK::OutputType type )
+{
+  typedef typename Grid::LeafGridView GridView;
+  constexpr static int dim = GridView :: dimension;
+
+  const std::string name = "vtktest-" + std::to_string(dim) + "D-" + VTKDataMode(dm) + "-topology";
+  const GridView gridView = grid.leafGridView();
+
+  Dune :: VTKSequenceWriter< GridView > plain( gridView, name, ".", "", dm );
+  Dune :: VTKSequenceWriter< GridView > reuse( gridView, name + "-reuse", ".", "", dm );
+  reuse.reuseTopology();
+
+  auto vectordata = std::make_shared<VTKVectorFunction<GridView> >();
+  plain.addVertexData(vectordata);
+  reuse.addVertexData(vectordata);
+
+  int count = 0;
+  for (int refine = 0; refine < 2; ++refine)
+  {
+    for (int step = 0; step < 3; ++step, ++count)
+    {
+      const double time = 0.1*count;
+      vectordata->setTime(time);
+      plain.write(time, type);
+      reuse.write(time, type);
+    }
+    grid.globalRefine(1);
+  }
+
+  const std::string extension = (dim == 1 ? ".vtp" : ".vtu");
+  for (int i = 0; i < count; ++i)
+  {
+    std::stringstream suffix;
+    suffix << "-" << std::setw(5) << std::setfill('0') << i << extension;
+    checkFilesEqual(name + suffix.str(), name + "-reuse" + suffix.str());
+  }
+}
+
 template<int dim>
 void vtkCheck(const std::array<int,dim>& n,
               const Dune::FieldVector<double,dim>& h,
@@ -158,6 +220,14 @@ void vtkCheck(const std::array<int,dim>& n,
   doWrite( g.levelGridView( 0 ), Dune::VTK::nonconforming );
   doWrite( g.levelGridView( g.maxLevel() ), Dune::VTK::conforming );
   doWrite( g.levelGridView( g.maxLevel() ), Dune::VTK::nonconforming );
+
+  if (g.comm().size() == 1)
+  {
+    Dune::YaspGrid<dim> conforming(h, n);
+    checkReuseTopology( conforming, Dune::VTK::conforming, Dune::VTK::ascii );
+    Dune::YaspGrid<dim> nonconforming(h, n);
+    checkReuseTopology( nonconforming, Dune::VTK::nonconforming, Dune::VTK::appendedraw );
+  }
 }
 
 int main(int argc, char **argv)
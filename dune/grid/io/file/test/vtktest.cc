@@ -156,6 +156,19 @@ int doWrite( Dune::VTKChecker& vtkChecker, const std::string& gridViewName, cons
                    Dune::VTK::appendedbase64);
   if(rank == 0) vtkChecker.push(name);
 
+  // Int64 connectivity and UInt64 block headers, as used for more than 2^31 corners
+  vtk.force64BitIndices();
+
+  name = vtk.write(prefix.str() + "-base64-int64", Dune::VTK::base64);
+  if(rank == 0) vtkChecker.push(name);
+
+  name = vtk.write(prefix.str() + "-appendedraw-int64", Dune::VTK::appendedraw);
+  if(rank == 0) vtkChecker.push(name);
+
+  name = vtk.write(prefix.str() + "-appendedbase64-int64",
+                   Dune::VTK::appendedbase64);
+  if(rank == 0) vtkChecker.push(name);
+
   return result;
 }
 
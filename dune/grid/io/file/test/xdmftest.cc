@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#include "config.h"
+
+#include <array>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/yaspgrid.hh>
+#include <dune/grid/io/file/xdmfwriter.hh>
+
+/* Write XDMF output with one heavy data file per process and with a single
+ * aggregated file and check the sizes of the heavy data.
+ */
+
+std::size_t fileSize (const std::string& fileName)
+{
+  std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+  if (!file)
+    DUNE_THROW(Dune::IOError, "Could not open " << fileName);
+  return file.tellg();
+}
+
+template<class GridView>
+class VectorFunction
+  : public Dune::VTKFunction<GridView>
+{
+  typedef typename GridView::template Codim<0>::Entity Entity;
+  constexpr static int dim = GridView::dimension;
+
+public:
+  int ncomps () const override { return dim; }
+
+  double evaluate (int comp, const Entity& e, const Dune::FieldVector<typename GridView::ctype,dim>& xi) const override
+  {
+    return e.geometry().global(xi)[comp];
+  }
+
+  std::string name () const override { return "position"; }
+};
+
+template<int dim>
+int check (const std::string& prefix)
+{
+  typedef typename Dune::YaspGrid<dim>::LeafGridView GridView;
+
+  std::array<int,dim> cells;
+  cells.fill(4);
+  Dune::YaspGrid<dim> grid(Dune::FieldVector<double,dim>(1.0), cells);
+  const GridView gridView = grid.leafGridView();
+  const auto& comm = gridView.comm();
+
+  std::vector<double> cellData(gridView.size(0), 1.0);
+  std::vector<double> vertexData(gridView.size(dim), 2.0);
+  std::vector<int> markers(gridView.size(0), 3);
+
+  // number of bytes per process: topology (type, corners), coordinates, data
+  std::size_t nCells = 0;
+  for ([[maybe_unused]] const auto& element : elements(gridView, Dune::Partitions::interiorBorder))
+    ++nCells;
+  const std::size_t corners = (1 << dim);
+
+  int result = 0;
+  for (bool aggregate : {false, true})
+  {
+    Dune::XdmfWriter<GridView> writer(gridView, Dune::VTK::nonconforming, Dune::VTK::Precision::float64, aggregate);
+    writer.addCellData(cellData, "cellData");
+    writer.addCellData(markers, "markers", 1, Dune::VTK::Precision::uint8);
+    writer.addVertexData(vertexData, "vertexData");
+    writer.addVertexData(std::make_shared<VectorFunction<GridView> >());
+
+    const std::string name = prefix + "-" + std::to_string(dim) + "d" + (aggregate ? "-aggregated" : "");
+    writer.write(name);
+
+    const std::size_t nVertices = corners*nCells;
+    const std::size_t bytes = 4*nCells*(1 + corners) + 8*3*nVertices + 4*nCells + nCells + 4*nVertices + 4*3*nVertices;
+
+    std::size_t expected = bytes, found = 0;
+    if (aggregate || (comm.size() == 1))
+    {
+      expected = comm.sum(bytes);
+      found = fileSize(name + ".bin");
+    }
+    else
+    {
+      std::ostringstream partName;
+      partName << name << "-p" << std::setw(4) << std::setfill('0') << comm.rank() << ".bin";
+      found = fileSize(partName.str());
+    }
+
+    if (found != expected)
+    {
+      std::cerr << "Wrong size of heavy data for " << name << ": " << found << " instead of " << expected << std::endl;
+      result = 1;
+    }
+
+    if (comm.rank() == 0)
+    {
+      std::ifstream descriptor(name + ".xmf");
+      std::stringstream content;
+      content << descriptor.rdbuf();
+      // the markers keep their integer type
+      if ((content.str().find("TopologyType=\"Mixed\"") == std::string::npos)
+          || (content.str().find("NumberType=\"UChar\" Precision=\"1\"") == std::string::npos))
+      {
+        std::cerr << "Descriptor " << name << ".xmf is incomplete" << std::endl;
+        result = 1;
+      }
+    }
+  }
+  return result;
+}
+
+int main (int argc, char** argv)
+try
+{
+  const auto& mpiHelper = Dune::MPIHelper::instance(argc, argv);
+  const std::string prefix = "xdmftest-np" + std::to_string(mpiHelper.size());
+
+  int result = 0;
+  result += check<2>(prefix);
+  result += check<3>(prefix);
+  return result;
+}
+catch (Dune::Exception& e)
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
@@ -273,7 +273,9 @@ namespace Dune
       uint8,
       uint32,
       float32,
-      float64
+      float64,
+      int64,
+      uint64
     };
 
     //! map precision to VTK type name
@@ -291,6 +293,10 @@ namespace Dune
           return "UInt8";
         case Precision::int32:
           return "Int32";
+        case Precision::int64:
+          return "Int64";
+        case Precision::uint64:
+          return "UInt64";
         default:
           DUNE_THROW(Dune::NotImplemented, "Unknown precision type");
       }
@@ -311,6 +317,10 @@ namespace Dune
           return sizeof(std::uint8_t);
         case Precision::int32:
           return sizeof(std::int32_t);
+        case Precision::int64:
+          return sizeof(std::int64_t);
+        case Precision::uint64:
+          return sizeof(std::uint64_t);
         default:
           DUNE_THROW(Dune::NotImplemented, "Unknown precision type");
       }
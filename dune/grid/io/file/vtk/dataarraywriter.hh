@@ -12,6 +12,8 @@
 #include <iomanip>
 #include <cstdint>
 #include <cmath>
+#include <limits>
+#include <vector>
 
 #include <dune/common/exceptions.hh>
 #include <dune/common/indent.hh>
@@ -80,6 +82,10 @@ namespace Dune
             writeUInt8(data); break;
           case Precision::int32:
             writeInt32(data); break;
+          case Precision::int64:
+            writeInt64(data); break;
+          case Precision::uint64:
+            writeUInt64(data); break;
           default:
             DUNE_THROW(Dune::NotImplemented, "Unknown precision type");
         }
@@ -101,6 +107,23 @@ namespace Dune
       virtual void writeUInt8 (std::uint8_t data) = 0;
       //! write one data element as unsigned integer
       virtual void writeUInt32 (std::uint32_t data) = 0;
+      //! write one data element as 64 bit integer
+      /**
+       * The default implementation throws NotImplemented, so that writers
+       * derived outside of dune-grid keep compiling.
+       */
+      virtual void writeInt64 (std::int64_t)
+      {
+        DUNE_THROW(Dune::NotImplemented, "This DataArrayWriter does not support Int64");
+      }
+      //! write one data element as 64 bit unsigned integer
+      /**
+       * The default implementation throws NotImplemented.
+       */
+      virtual void writeUInt64 (std::uint64_t)
+      {
+        DUNE_THROW(Dune::NotImplemented, "This DataArrayWriter does not support UInt64");
+      }
 
       Precision prec;
     };
@@ -153,6 +176,12 @@ namespace Dune
       //! write one unsigned int data element to output stream
       void writeUInt8 (std::uint8_t data) final
       { write_(data); }
+      //! write one 64 bit int data element to output stream
+      void writeInt64 (std::int64_t data) final
+      { write_(data); }
+      //! write one 64 bit unsigned int data element to output stream
+      void writeUInt64 (std::uint64_t data) final
+      { write_(data); }
 
       template<class T>
       void write_(T data)
@@ -192,6 +221,21 @@ namespace Dune
       Indent indent;
     };
 
+    //! write the byte count heading a binary data block as UInt32 or UInt64
+    template<class Stream>
+    void writeBlockHeader(Stream& stream, std::uint64_t bytes, Precision headerType)
+    {
+      if (headerType == Precision::uint64)
+        stream.write(bytes);
+      else
+      {
+        if (bytes > std::numeric_limits<std::uint32_t>::max())
+          DUNE_THROW(IOError, "VTK data array of " << bytes << " bytes needs header type UInt64");
+        std::uint32_t header = bytes;
+        stream.write(header);
+      }
+    }
+
     //! a streaming writer for data array tags, uses binary inline format
     class BinaryDataArrayWriter : public DataArrayWriter
     {
@@ -206,9 +250,11 @@ namespace Dune
        * \param indent_   Indentation to use.  This is use as-is for the
        *                  header and trailer lines, but increase by one level
        *                  for the actual data.
+       * \param headerType Type of the byte count heading the data, UInt32 or UInt64
        */
       BinaryDataArrayWriter(std::ostream& theStream, std::string name,
-                            int ncomps, int nitems, const Indent& indent_, Precision prec_)
+                            int ncomps, std::size_t nitems, const Indent& indent_, Precision prec_,
+                            Precision headerType = Precision::uint32)
         : DataArrayWriter(prec_), s(theStream), b64(theStream), indent(indent_)
       {
         s << indent << "<DataArray type=\"" << toString(prec_) << "\" "
@@ -218,9 +264,8 @@ namespace Dune
 
         // write indentation for the data chunk
         s << indent+1;
-        // store size, needs to be exactly 32 bit
-        std::uint32_t size = ncomps*nitems*typeSize(prec_);
-        b64.write(size);
+        // store size, needs to be exactly of the header type
+        writeBlockHeader(b64, ncomps*nitems*typeSize(prec_), headerType);
         b64.flush();
       }
 
@@ -250,6 +295,12 @@ namespace Dune
       //! write one unsigned int data element to output stream
       void writeUInt8 (std::uint8_t data) final
       { write_(data); }
+      //! write one 64 bit int data element to output stream
+      void writeInt64 (std::int64_t data) final
+      { write_(data); }
+      //! write one 64 bit unsigned int data element to output stream
+      void writeUInt64 (std::uint64_t data) final
+      { write_(data); }
 
       //! write one data element to output stream
       template<class T>
@@ -279,17 +330,19 @@ namespace Dune
        *                  section later.
        * \param indent    Indentation to use.  This is uses as-is for the
        *                  header line.
+       * \param headerType Type of the byte count heading the data, UInt32 or UInt64
        */
       AppendedRawDataArrayWriter(std::ostream& s, std::string name,
-                                 int ncomps, unsigned nitems, unsigned& offset,
-                                 const Indent& indent, Precision prec_)
+                                 int ncomps, std::size_t nitems, std::uint64_t& offset,
+                                 const Indent& indent, Precision prec_,
+                                 Precision headerType = Precision::uint32)
       : DataArrayWriter(prec_)
       {
         s << indent << "<DataArray type=\"" << toString(prec_) << "\" "
           << "Name=\"" << name << "\" ";
         s << "NumberOfComponents=\"" << ncomps << "\" ";
         s << "format=\"appended\" offset=\""<< offset << "\" />\n";
-        offset += 4; // header
+        offset += typeSize(headerType); // header
         offset += ncomps*nitems*typeSize(prec_);
       }
 
@@ -303,6 +356,8 @@ namespace Dune
       void writeInt32 (std::int32_t) final {}
       void writeUInt32 (std::uint32_t) final {}
       void writeUInt8 (std::uint8_t) final {}
+      void writeInt64 (std::int64_t) final {}
+      void writeUInt64 (std::uint64_t) final {}
     };
 
     //! a streaming writer for data array tags, uses appended base64 format
@@ -321,17 +376,19 @@ namespace Dune
        *                  appended data section later.
        * \param indent    Indentation to use.  This is uses as-is for the
        *                  header line.
+       * \param headerType Type of the byte count heading the data, UInt32 or UInt64
        */
       AppendedBase64DataArrayWriter(std::ostream& s, std::string name,
-                                    int ncomps, unsigned nitems,
-                                    unsigned& offset, const Indent& indent, Precision prec_)
+                                    int ncomps, std::size_t nitems,
+                                    std::uint64_t& offset, const Indent& indent, Precision prec_,
+                                    Precision headerType = Precision::uint32)
       : DataArrayWriter(prec_)
       {
         s << indent << "<DataArray type=\"" << toString(prec_) << "\" "
           << "Name=\"" << name << "\" ";
         s << "NumberOfComponents=\"" << ncomps << "\" ";
         s << "format=\"appended\" offset=\""<< offset << "\" />\n";
-        offset += 8; // header
+        offset += (typeSize(headerType)+2)/3*4; // header
         std::size_t bytes = ncomps*nitems*typeSize(prec_);
         offset += bytes/3*4;
         if(bytes%3 != 0)
@@ -348,6 +405,8 @@ namespace Dune
       void writeInt32 (std::int32_t) final {}
       void writeUInt32 (std::uint32_t) final {}
       void writeUInt8 (std::uint8_t) final {}
+      void writeInt64 (std::int64_t) final {}
+      void writeUInt64 (std::uint64_t) final {}
     };
 
     //////////////////////////////////////////////////////////////////////
@@ -365,14 +424,15 @@ namespace Dune
        * \param ncomps    Number of components of the array.
        * \param nitems    Number of cells for cell data/Number of vertices for
        *                  point data.
+       * \param headerType Type of the byte count heading the data, UInt32 or UInt64
        */
       NakedBase64DataArrayWriter(std::ostream& theStream, int ncomps,
-                                 int nitems, Precision prec_)
+                                 std::size_t nitems, Precision prec_,
+                                 Precision headerType = Precision::uint32)
         : DataArrayWriter(prec_), b64(theStream)
       {
         // store size
-        std::uint32_t size = ncomps*nitems*typeSize(prec_);
-        b64.write(size);
+        writeBlockHeader(b64, ncomps*nitems*typeSize(prec_), headerType);
         b64.flush();
       }
 
@@ -392,6 +452,12 @@ namespace Dune
       //! write one unsigned int data element to output stream
       void writeUInt8 (std::uint8_t data) final
       { write_(data); }
+      //! write one 64 bit int data element to output stream
+      void writeInt64 (std::int64_t data) final
+      { write_(data); }
+      //! write one 64 bit unsigned int data element to output stream
+      void writeUInt64 (std::uint64_t data) final
+      { write_(data); }
 
       //! write one data element to output stream
       template<class T>
@@ -415,12 +481,14 @@ namespace Dune
        * \param ncomps    Number of components of the array.
        * \param nitems    Number of cells for cell data/Number of vertices for
        *                  point data.
+       * \param headerType Type of the byte count heading the data, UInt32 or UInt64
        */
       NakedRawDataArrayWriter(std::ostream& theStream, int ncomps,
-                              int nitems, Precision prec_)
+                              std::size_t nitems, Precision prec_,
+                              Precision headerType = Precision::uint32)
         : DataArrayWriter(prec_), s(theStream)
       {
-        s.write((unsigned int)(ncomps*nitems*typeSize(prec_)));
+        writeBlockHeader(s, ncomps*nitems*typeSize(prec_), headerType);
       }
 
     private:
@@ -439,6 +507,12 @@ namespace Dune
       //! write one unsigned int data element to output stream
       void writeUInt8 (std::uint8_t data) final
       { write_(data); }
+      //! write one 64 bit int data element to output stream
+      void writeInt64 (std::int64_t data) final
+      { write_(data); }
+      //! write one 64 bit unsigned int data element to output stream
+      void writeUInt64 (std::uint64_t data) final
+      { write_(data); }
 
       //! write one data element to output stream
       template<class T>
@@ -448,6 +522,38 @@ namespace Dune
       }
     };
 
+    //! a data array writer collecting the values into a vector
+    /**
+     * Used by writers which evaluate the data first and write whole arrays
+     * afterwards, e.g., into HDF5 data sets or raw binary files.
+     */
+    class VectorDataArrayWriter : public DataArrayWriter
+    {
+    public:
+      //! make a new data array writer appending to data
+      explicit VectorDataArrayWriter(std::vector<double>& data)
+        : DataArrayWriter(Precision::float64), data_(data)
+      {}
+
+    private:
+      void writeFloat64 (double data) final
+      { data_.push_back(data); }
+      void writeFloat32 (float data) final
+      { data_.push_back(data); }
+      void writeInt32 (std::int32_t data) final
+      { data_.push_back(data); }
+      void writeUInt32 (std::uint32_t data) final
+      { data_.push_back(data); }
+      void writeUInt8 (std::uint8_t data) final
+      { data_.push_back(data); }
+      void writeInt64 (std::int64_t data) final
+      { data_.push_back(data); }
+      void writeUInt64 (std::uint64_t data) final
+      { data_.push_back(data); }
+
+      std::vector<double>& data_;
+    };
+
     //////////////////////////////////////////////////////////////////////
     //
     //  Factory
@@ -464,7 +570,8 @@ namespace Dune
 
       OutputType type;
       std::ostream& stream;
-      unsigned offset;
+      Precision headerType;
+      std::uint64_t offset;
       //! whether we are in the main or in the appended section writing phase
       Phase phase;
 
@@ -473,14 +580,17 @@ namespace Dune
       /**
        * \param type_   Type of DataArrayWriters to create
        * \param stream_ The stream that the DataArrayWriters will write to.
+       * \param headerType_ Type of the byte counts heading binary data, UInt32
+       *                    or UInt64
        *
        * Better avoid having multiple active factories on the same stream at
        * the same time.  Having an inactive factory (one whose make() method
        * is not called anymore before destruction) around at the same time as
        * an active one should be OK however.
        */
-      inline DataArrayWriterFactory(OutputType type_, std::ostream& stream_)
-        : type(type_), stream(stream_), offset(0), phase(main)
+      inline DataArrayWriterFactory(OutputType type_, std::ostream& stream_,
+                                    Precision headerType_ = Precision::uint32)
+        : type(type_), stream(stream_), headerType(headerType_), offset(0), phase(main)
       { }
 
       //! signal start of the appended section
@@ -539,7 +649,7 @@ namespace Dune
        * around.  The returned object should be freed with delete.
        */
       DataArrayWriter* make(const std::string& name, unsigned ncomps,
-                            unsigned nitems, const Indent& indent,
+                            std::size_t nitems, const Indent& indent,
                             Precision prec)
       {
         switch(phase) {
@@ -549,14 +659,15 @@ namespace Dune
             return new AsciiDataArrayWriter(stream, name, ncomps, indent, prec);
           case base64 :
             return new BinaryDataArrayWriter(stream, name, ncomps, nitems,
-                                             indent, prec);
+                                             indent, prec, headerType);
           case appendedraw :
             return new AppendedRawDataArrayWriter(stream, name, ncomps,
-                                                  nitems, offset, indent, prec);
+                                                  nitems, offset, indent, prec,
+                                                  headerType);
           case appendedbase64 :
             return new AppendedBase64DataArrayWriter(stream, name, ncomps,
                                                      nitems, offset,
-                                                     indent, prec);
+                                                     indent, prec, headerType);
           }
           break;
         case appended :
@@ -565,9 +676,11 @@ namespace Dune
           case base64 :
             break; // invalid in appended mode
           case appendedraw :
-            return new NakedRawDataArrayWriter(stream, ncomps, nitems, prec);
+            return new NakedRawDataArrayWriter(stream, ncomps, nitems, prec,
+                                               headerType);
           case appendedbase64 :
-            return new NakedBase64DataArrayWriter(stream, ncomps, nitems, prec);
+            return new NakedBase64DataArrayWriter(stream, ncomps, nitems, prec,
+                                                  headerType);
           }
           break;
         }
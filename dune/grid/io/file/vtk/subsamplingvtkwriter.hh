@@ -6,8 +6,12 @@
 #ifndef DUNE_SUBSAMPLINGVTKWRITER_HH
 #define DUNE_SUBSAMPLINGVTKWRITER_HH
 
-#include <ostream>
+#include <algorithm>
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <ostream>
+#include <vector>
 
 #include <dune/common/indent.hh>
 #include <dune/geometry/type.hh>
@@ -94,96 +98,25 @@ namespace Dune
       return (geometryType.isCube() && !coerceToSimplex ? geometryType : GeometryTypes::simplex(dim));
     }
 
-    template<typename SubIterator>
-    struct IteratorSelector
-    {};
-
-    SubElementIterator refinementBegin(const Refinement& refinement, Dune::RefinementIntervals intervals, IteratorSelector<SubElementIterator>)
-    {
-      return refinement.eBegin(intervals);
-    }
-
-    SubVertexIterator refinementBegin(const Refinement& refinement, Dune::RefinementIntervals intervals, IteratorSelector<SubVertexIterator>)
-    {
-      return refinement.vBegin(intervals);
-    }
-
-    SubElementIterator refinementEnd(const Refinement& refinement, Dune::RefinementIntervals intervals, IteratorSelector<SubElementIterator>)
+    // refinement of an element type, built once and applied to all elements of this type
+    struct Pattern
     {
-      return refinement.eEnd(intervals);
-    }
-
-    SubVertexIterator refinementEnd(const Refinement& refinement, Dune::RefinementIntervals intervals, IteratorSelector<SubVertexIterator>)
-    {
-      return refinement.vEnd(intervals);
-    }
-
-    template<typename Data, typename Iterator, typename SubIterator>
-    void writeData(VTK::VTUWriter& writer, const Data& data, const Iterator begin, const Iterator end, int nentries, IteratorSelector<SubIterator> sis)
-    {
-      for (auto it = data.begin(),
-             iend = data.end();
-           it != iend;
-           ++it)
-      {
-        const auto& f = *it;
-        VTK::FieldInfo fieldInfo = f.fieldInfo();
-        std::size_t writecomps = fieldInfo.size();
-        switch (fieldInfo.type())
-          {
-          case VTK::FieldInfo::Type::scalar:
-            break;
-          case VTK::FieldInfo::Type::vector:
-            // vtk file format: a vector data always should have 3 comps (with
-            // 3rd comp = 0 in 2D case)
-            if (writecomps > 3)
-              DUNE_THROW(IOError,"Cannot write VTK vectors with more than 3 components (components was " << writecomps << ")");
-            writecomps = 3;
-            break;
-          case VTK::FieldInfo::Type::tensor:
-            DUNE_THROW(NotImplemented,"VTK output for tensors not implemented yet");
-          }
-        std::shared_ptr<VTK::DataArrayWriter> p
-          (writer.makeArrayWriter(f.name(), writecomps, nentries, fieldInfo.precision()));
-        if(!p->writeIsNoop())
-          for (Iterator eit = begin; eit!=end; ++eit)
-          {
-            const Entity & e = *eit;
-            f.bind(e);
-            Refinement &refinement =
-              buildRefinement<dim, ctype>(eit->type(),
-                                          subsampledGeometryType(eit->type()));
-            for(SubIterator sit = refinementBegin(refinement,intervals,sis),
-                  send = refinementEnd(refinement,intervals,sis);
-                sit != send;
-                ++sit)
-              {
-                f.write(sit.coords(),*p);
-                // expand 2D-Vectors to 3D for VTK format
-                for(unsigned j = f.fieldInfo().size(); j < writecomps; j++)
-                  p->write(0.0);
-              }
-            f.unbind();
-          }
-      }
-    }
-
+      // type of the sub-elements
+      GeometryType type;
+      // local coordinates of the sub-vertices and of the centers of the sub-elements
+      std::vector<FieldVector<ctype, dim> > vertices;
+      std::vector<FieldVector<ctype, dim> > centers;
+      // corners of the sub-elements in VTK numbering
+      std::vector<std::int64_t> connectivity;
+      int corners = 0;
+    };
+
+    //! return the refinement pattern of an element type, building it on first use
+    const Pattern& pattern(GeometryType geometryType);
 
   protected:
-    //! count the vertices, cells and corners
-    virtual void countEntities(int &nvertices_, int &ncells_, int &ncorners_);
-
-    //! write cell data
-    virtual void writeCellData(VTK::VTUWriter& writer);
-
-    //! write vertex data
-    virtual void writeVertexData(VTK::VTUWriter& writer);
-
-    //! write the positions of vertices
-    virtual void writeGridPoints(VTK::VTUWriter& writer);
-
-    //! write the connectivity array
-    virtual void writeGridCells(VTK::VTUWriter& writer);
+    //! gather the subsampled grid and all data in a single grid traversal
+    virtual bool gatherData();
 
   public:
     using Base::addVertexData;
@@ -200,166 +133,121 @@ namespace Dune
 
     Dune::RefinementIntervals intervals;
     bool coerceToSimplex;
+    // refinement patterns for the element types seen so far; the intervals are fixed
+    std::map<GeometryType, Pattern> patterns_;
   };
 
-  //! count the vertices, cells and corners
+  //! return the refinement pattern of an element type, building it on first use
   template <class GridView>
-  void SubsamplingVTKWriter<GridView>::countEntities(int &nvertices_, int &ncells_, int &ncorners_)
+  const typename SubsamplingVTKWriter<GridView>::Pattern&
+  SubsamplingVTKWriter<GridView>::pattern(GeometryType geometryType)
   {
-    nvertices_ = 0;
-    ncells_ = 0;
-    ncorners_ = 0;
-    for (CellIterator it=this->cellBegin(); it!=cellEnd(); ++it)
+    auto it = patterns_.find(geometryType);
+    if (it != patterns_.end())
+      return it->second;
+
+    Pattern &p = patterns_[geometryType];
+    p.type = subsampledGeometryType(geometryType);
+    Refinement &refinement = buildRefinement<dim, ctype>(geometryType, p.type);
+    for(SubVertexIterator sit = refinement.vBegin(intervals),
+        send = refinement.vEnd(intervals);
+        sit != send; ++sit)
+      p.vertices.push_back(sit.coords());
+    for(SubElementIterator sit = refinement.eBegin(intervals),
+        send = refinement.eEnd(intervals);
+        sit != send; ++sit)
     {
-      Refinement &refinement = buildRefinement<dim, ctype>(it->type(), subsampledGeometryType(it->type()));
-
-      ncells_ += refinement.nElements(intervals);
-      nvertices_ += refinement.nVertices(intervals);
-      ncorners_ += refinement.nElements(intervals) * refinement.eBegin(intervals).vertexIndices().size();
+      p.centers.push_back(sit.coords());
+      IndexVector indices = sit.vertexIndices();
+      p.corners = indices.size();
+      for(unsigned int ii = 0; ii < indices.size(); ++ii)
+        p.connectivity.push_back(indices[VTK::renumber(p.type, ii)]);
     }
+    return p;
   }
 
-
-  //! write cell data
-  template <class GridView>
-  void SubsamplingVTKWriter<GridView>::writeCellData(VTK::VTUWriter& writer)
-  {
-    if(celldata.size() == 0)
-      return;
-
-    // Find the names of the first scalar and vector data fields.
-    // These will be marked as the default fields (the ones that ParaView shows
-    // when the file has just been opened).
-    std::string defaultScalarField, defaultVectorField;
-    std::tie(defaultScalarField, defaultVectorField) = this->getDataNames(celldata);
-
-    writer.beginCellData(defaultScalarField, defaultVectorField);
-    writeData(writer,celldata,cellBegin(),cellEnd(),ncells,IteratorSelector<SubElementIterator>());
-    writer.endCellData();
-  }
-
-  //! write vertex data
+  //! gather the subsampled grid and all data in a single grid traversal
   template <class GridView>
-  void SubsamplingVTKWriter<GridView>::writeVertexData(VTK::VTUWriter& writer)
+  bool SubsamplingVTKWriter<GridView>::gatherData()
   {
-    if(vertexdata.size() == 0)
-      return;
-
-    // Find the names of the first scalar and vector data fields.
-    // These will be marked as the default fields (the ones that ParaView shows
-    // when the file has just been opened).
-    std::string defaultScalarField, defaultVectorField;
-    std::tie(defaultScalarField, defaultVectorField) = this->getDataNames(vertexdata);
+    const bool topology = !this->topologyUpToDate();
+    if (topology)
+    {
+      this->topologyChanged();
+      ncells = nvertices = ncorners = 0;
+    }
 
-    writer.beginPointData(defaultScalarField, defaultVectorField);
-    writeData(writer,vertexdata,cellBegin(),cellEnd(),nvertices,IteratorSelector<SubVertexIterator>());
-    writer.endPointData();
-  }
+    std::vector<VTK::VectorDataArrayWriter> cellWriters, vertexWriters;
+    this->beginStaging(cellWriters, vertexWriters);
+    const auto &staging = this->staging();
 
-  //! write the positions of vertices
-  template <class GridView>
-  void SubsamplingVTKWriter<GridView>::writeGridPoints(VTK::VTUWriter& writer)
-  {
-    writer.beginPoints();
+    // The offset within the index numbering
+    std::int64_t offset = 0;
+    for (CellIterator it=cellBegin(); it!=cellEnd(); ++it)
+    {
+      const Entity &e = *it;
+      const Pattern &p = pattern(e.type());
 
-    std::shared_ptr<VTK::DataArrayWriter> p
-      (writer.makeArrayWriter("Coordinates", 3, nvertices, this->coordPrecision()));
-    if(!p->writeIsNoop())
-      for (CellIterator i=cellBegin(); i!=cellEnd(); ++i)
+      // each function is bound once and evaluated at all points of the pattern
+      std::size_t k = 0;
+      for (const auto &f : celldata)
       {
-        Refinement &refinement =
-          buildRefinement<dim, ctype>(i->type(),
-                                      subsampledGeometryType(i->type()));
-        for(SubVertexIterator sit = refinement.vBegin(intervals),
-            send = refinement.vEnd(intervals);
-            sit != send; ++sit)
+        f.bind(e);
+        for (const auto &x : p.centers)
         {
-          FieldVector<ctype, dimw> coords = i->geometry().global(sit.coords());
-          for (int j=0; j<std::min(int(dimw),3); j++)
-            p->write(coords[j]);
-          for (int j=std::min(int(dimw),3); j<3; j++)
-            p->write(0.0);
+          f.write(x, cellWriters[k]);
+          Base::pad(f.fieldInfo(), staging.cellComponents[k], cellWriters[k]);
         }
+        f.unbind();
+        ++k;
       }
-    // free the VTK::DataArrayWriter before touching the stream
-    p.reset();
 
-    writer.endPoints();
-  }
-
-  //! write the connectivity array
-  template <class GridView>
-  void SubsamplingVTKWriter<GridView>::writeGridCells(VTK::VTUWriter& writer)
-  {
-    writer.beginCells();
-
-    // connectivity
-    {
-      std::shared_ptr<VTK::DataArrayWriter> p1
-        (writer.makeArrayWriter("connectivity", 1, ncorners, VTK::Precision::int32));
-      // The offset within the index numbering
-      if(!p1->writeIsNoop()) {
-        int offset = 0;
-        for (CellIterator i=cellBegin(); i!=cellEnd(); ++i)
+      k = 0;
+      for (const auto &f : vertexdata)
+      {
+        f.bind(e);
+        for (const auto &x : p.vertices)
         {
-          GeometryType coercedToType = subsampledGeometryType(i->type());
-          Refinement &refinement =
-            buildRefinement<dim, ctype>(i->type(), coercedToType);
-          for(SubElementIterator sit = refinement.eBegin(intervals),
-              send = refinement.eEnd(intervals);
-              sit != send; ++sit)
-          {
-            IndexVector indices = sit.vertexIndices();
-            for(unsigned int ii = 0; ii < indices.size(); ++ii)
-              p1->write(offset+indices[VTK::renumber(coercedToType, ii)]);
-          }
-          offset += refinement.nVertices(intervals);
+          f.write(x, vertexWriters[k]);
+          Base::pad(f.fieldInfo(), staging.vertexComponents[k], vertexWriters[k]);
         }
+        f.unbind();
+        ++k;
       }
-    }
 
-    // offsets
-    {
-      std::shared_ptr<VTK::DataArrayWriter> p2
-        (writer.makeArrayWriter("offsets", 1, ncells,  VTK::Precision::int32));
-      if(!p2->writeIsNoop()) {
-        // The offset into the connectivity array
-        int offset = 0;
-        for (CellIterator i=cellBegin(); i!=cellEnd(); ++i)
+      if (topology)
+      {
+        const auto geometry = e.geometry();
+        for (const auto &x : p.vertices)
         {
-          Refinement &refinement =
-            buildRefinement<dim, ctype>(i->type(),
-                                        subsampledGeometryType(i->type()));
-          unsigned int verticesPerCell =
-            refinement.eBegin(intervals).vertexIndices().size();
-          for(int element = 0; element < refinement.nElements(intervals);
-              ++element)
-          {
-            offset += verticesPerCell;
-            p2->write(offset);
-          }
+          const FieldVector<ctype, dimw> coords = geometry.global(x);
+          for (int j=0; j<3; j++)
+            this->topology_.coordinates.push_back(j < std::min(int(dimw),3) ? double(coords[j]) : 0.0);
         }
-      }
-    }
 
-    // types
-    if (dim>1)
-    {
-      std::shared_ptr<VTK::DataArrayWriter> p3
-        (writer.makeArrayWriter("types", 1, ncells, VTK::Precision::uint8));
-      if(!p3->writeIsNoop())
-        for (CellIterator it=cellBegin(); it!=cellEnd(); ++it)
+        const int vtktype = VTK::geometryType(p.type);
+        for (std::size_t c = 0; c < p.centers.size(); ++c)
         {
-          GeometryType coerceTo = subsampledGeometryType(it->type());
-          Refinement &refinement =
-            buildRefinement<dim, ctype>(it->type(), coerceTo);
-          int vtktype = VTK::geometryType(coerceTo);
-          for(int i = 0; i < refinement.nElements(intervals); ++i)
-            p3->write(vtktype);
+          for (int j = 0; j < p.corners; ++j)
+            this->topology_.connectivity.push_back(offset + p.connectivity[c*p.corners + j]);
+          ncorners += p.corners;
+          this->topology_.offsets.push_back(ncorners);
+          this->topology_.types.push_back(vtktype);
         }
+        ncells += p.centers.size();
+        nvertices += p.vertices.size();
+      }
+      offset += p.vertices.size();
     }
 
-    writer.endCells();
+    if (topology)
+    {
+      this->topology_.gridCells = this->gridView_.size(0);
+      this->topology_.gridVertices = this->gridView_.size(dim);
+      this->topology_.valid = true;
+    }
+    this->staging_.valid = true;
+    return topology;
   }
 }
 
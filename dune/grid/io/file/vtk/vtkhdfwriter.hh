@@ -0,0 +1,473 @@
+// SPDX-FileCopyrightText: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_IO_FILE_VTK_VTKHDFWRITER_HH
+#define DUNE_GRID_IO_FILE_VTK_VTKHDFWRITER_HH
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+
+#include <dune/grid/io/file/vtk/common.hh>
+#include <dune/grid/io/file/vtk/dataarraywriter.hh>
+#include <dune/grid/io/file/vtk/vtkwriter.hh>
+
+#if HAVE_HDF5
+
+#include <hdf5.h>
+
+#if HAVE_MPI
+#include <mpi.h>
+#endif // #if HAVE_MPI
+
+/** @file
+    @author DUNE Project contributors
+    @brief Provides a single-file writer for the VTKHDF format
+ */
+
+namespace Dune
+{
+
+  namespace VTK
+  {
+
+    // HDF5Handle
+    // ----------
+
+    //! owns an HDF5 identifier and closes it on destruction
+    class HDF5Handle
+    {
+    public:
+      HDF5Handle ( hid_t id, herr_t (*close)( hid_t ), const std::string &what )
+        : id_( id ), close_( close )
+      {
+        if( id_ < 0 )
+          DUNE_THROW( IOError, "VTKHDFWriter: " << what << " failed" );
+      }
+
+      HDF5Handle ( const HDF5Handle & ) = delete;
+      HDF5Handle &operator= ( const HDF5Handle & ) = delete;
+
+      ~HDF5Handle () { close_( id_ ); }
+
+      operator hid_t () const { return id_; }
+
+    private:
+      hid_t id_;
+      herr_t (*close_)( hid_t );
+    };
+
+    inline void checkHDF5 ( herr_t status, const std::string &what )
+    {
+      if( status < 0 )
+        DUNE_THROW( IOError, "VTKHDFWriter: " << what << " failed" );
+    }
+
+    //! HDF5 file type (little endian, as written by VTK) of a precision
+    inline hid_t hdf5FileType ( Precision precision )
+    {
+      switch( precision )
+      {
+      case Precision::int32:
+        return H5T_STD_I32LE;
+      case Precision::uint8:
+        return H5T_STD_U8LE;
+      case Precision::uint32:
+        return H5T_STD_U32LE;
+      case Precision::float32:
+        return H5T_IEEE_F32LE;
+      case Precision::float64:
+        return H5T_IEEE_F64LE;
+      case Precision::int64:
+        return H5T_STD_I64LE;
+      case Precision::uint64:
+        return H5T_STD_U64LE;
+      }
+      DUNE_THROW( IOError, "VTKHDFWriter: unknown precision" );
+    }
+
+  } // namespace VTK
+
+
+
+  // VTKHDFWriter
+  // ------------
+
+  /**
+   * @brief Writer for the VTKHDF file format
+   * @ingroup VTK
+   *
+   * Writes the grid and the registered cell and vertex data of all processes into
+   * a single <tt>.vtkhdf</tt> file (an HDF5 file with the layout of VTK's
+   * vtkHDFReader). In parallel, HDF5 has to be built with MPI support; all
+   * processes then write their part of each array with collective MPI-IO, so that
+   * the number of files does not depend on the number of processes.
+   *
+   * Functions are registered through the interface of VTKWriter. write() creates
+   * a file holding one data set, writeTimeStep() appends a time step to a file
+   * using the temporal layout of VTKHDF. If reuseTopology() is enabled, time steps
+   * on an unchanged grid only store the data fields and refer to the grid written
+   * before.
+   *
+   * This writer is only available if HDF5 was found and the program is compiled
+   * with the flags added by add_dune_hdf5_flags.
+   *
+   * \tparam GridView Grid view of the grid we are writing
+   */
+  template< class GridView >
+  class VTKHDFWriter
+    : public VTKWriter< GridView >
+  {
+    typedef VTKWriter< GridView > Base;
+
+    using Base::celldata;
+    using Base::vertexdata;
+    using Base::gridView_;
+    using Base::ncells;
+    using Base::nvertices;
+    using Base::ncorners;
+
+    // global position of this process' part of an array
+    struct Slab
+    {
+      hsize_t offset = 0;
+      hsize_t count = 0;
+      hsize_t size = 0;
+    };
+
+  public:
+    /**
+     * @brief Construct a VTKHDFWriter working on a specific GridView.
+     *
+     * @param gridView The gridView the grid functions live on.
+     * @param dm The data mode.
+     * @param coordPrecision the precision with which to write out the coordinates
+     */
+    explicit VTKHDFWriter ( const GridView &gridView,
+                            VTK::DataMode dm = VTK::conforming,
+                            VTK::Precision coordPrecision = VTK::Precision::float32 )
+      : Base( gridView, dm, coordPrecision )
+    {
+      if( this->checkForPolyhedralCells() )
+        DUNE_THROW( NotImplemented, "VTKHDFWriter: polyhedral cells are not supported" );
+    }
+
+    /**
+     * @brief write the grid and the data into the file name.vtkhdf
+     *
+     * An existing file is overwritten. This method has to be called on all processes.
+     *
+     * \returns the name of the file written
+     */
+    std::string write ( const std::string &name )
+    {
+      const std::string fileName = name + ".vtkhdf";
+      Base::prepareData();
+      {
+        VTK::HDF5Handle file( createFile( fileName ), H5Fclose, "creating " + fileName );
+        VTK::HDF5Handle root( createRoot( file ), H5Gclose, "creating group VTKHDF" );
+        writePiece( root );
+      }
+      Base::releaseTopology();
+      return fileName;
+    }
+
+    /**
+     * @brief append a time step to the file name.vtkhdf
+     *
+     * The first call of this writer object creates the file, the following ones append
+     * to it. This method has to be called on all processes.
+     *
+     * \returns the name of the file written
+     */
+    std::string writeTimeStep ( const std::string &name, double time )
+    {
+      const std::string fileName = name + ".vtkhdf";
+      // writing the grid is collective, so it is rewritten on all processes if it changed on any
+      const bool changed = gridView_.comm().max( int( Base::prepareData() ) );
+      {
+        const bool create = (timeSeries_ != fileName);
+        VTK::HDF5Handle file( create ? createFile( fileName ) : openFile( fileName ), H5Fclose, "opening " + fileName );
+        VTK::HDF5Handle root( create ? createRoot( file ) : H5Gopen2( file, "VTKHDF", H5P_DEFAULT ), H5Gclose, "opening group VTKHDF" );
+        if( create )
+        {
+          VTK::HDF5Handle steps( H5Gcreate2( root, "Steps", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT ), H5Gclose, "creating group Steps" );
+          nSteps_ = 0;
+        }
+        VTK::HDF5Handle steps( H5Gopen2( root, "Steps", H5P_DEFAULT ), H5Gclose, "opening group Steps" );
+
+        // the grid is written again if it changed or if this is the first step
+        if( changed || create )
+          piece_ = writeGrid( root );
+
+        const bool master = (gridView_.comm().rank() == 0);
+        append( steps, "Values", H5T_NATIVE_DOUBLE, H5T_IEEE_F64LE, &time, rootSlab( master ), 0 );
+        append( steps, "PartOffsets", piece_.partOffset, master );
+        append( steps, "NumberOfParts", piece_.numberOfParts, master );
+        append( steps, "PointOffsets", piece_.pointOffset, master );
+        append( steps, "CellOffsets", piece_.cellOffset, master );
+        append( steps, "ConnectivityIdOffsets", piece_.connectivityOffset, master );
+
+        writeData( root, steps, "PointData", "PointDataOffsets", vertexdata, Base::staging().vertexValues, Base::staging().vertexComponents, nvertices );
+        writeData( root, steps, "CellData", "CellDataOffsets", celldata, Base::staging().cellValues, Base::staging().cellComponents, ncells );
+
+        ++nSteps_;
+        writeAttribute( steps, "NSteps", H5T_NATIVE_INT, H5T_STD_I32LE, &nSteps_, 0 );
+        timeSeries_ = fileName;
+      }
+      Base::releaseTopology();
+      return fileName;
+    }
+
+  private:
+    // offsets of the grid used by a time step
+    struct Piece
+    {
+      std::int64_t partOffset = 0;
+      std::int64_t numberOfParts = 0;
+      std::int64_t pointOffset = 0;
+      std::int64_t cellOffset = 0;
+      std::int64_t connectivityOffset = 0;
+    };
+
+    hid_t createFile ( const std::string &fileName ) const
+    {
+      VTK::HDF5Handle access( fileAccess(), H5Pclose, "creating file access list" );
+      return H5Fcreate( fileName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, access );
+    }
+
+    hid_t openFile ( const std::string &fileName ) const
+    {
+      VTK::HDF5Handle access( fileAccess(), H5Pclose, "creating file access list" );
+      return H5Fopen( fileName.c_str(), H5F_ACC_RDWR, access );
+    }
+
+    // file access property list, using MPI-IO in parallel
+    hid_t fileAccess () const
+    {
+      hid_t access = H5Pcreate( H5P_FILE_ACCESS );
+      if( gridView_.comm().size() > 1 )
+      {
+#if HAVE_MPI && defined(H5_HAVE_PARALLEL)
+        if constexpr (std::is_convertible_v< std::decay_t< decltype( gridView_.comm() ) >, MPI_Comm >)
+          VTK::checkHDF5( H5Pset_fapl_mpio( access, MPI_Comm( gridView_.comm() ), MPI_INFO_NULL ), "setting up MPI-IO" );
+        else
+        {
+          H5Pclose( access );
+          DUNE_THROW( NotImplemented, "VTKHDFWriter: parallel output requires a communication convertible to MPI_Comm" );
+        }
+#else // #if HAVE_MPI && defined(H5_HAVE_PARALLEL)
+        H5Pclose( access );
+        DUNE_THROW( NotImplemented, "VTKHDFWriter: parallel output requires HDF5 with MPI support" );
+#endif // #else // #if HAVE_MPI && defined(H5_HAVE_PARALLEL)
+      }
+      return access;
+    }
+
+    // data transfer property list, collective in parallel
+    hid_t transfer () const
+    {
+      hid_t transfer = H5Pcreate( H5P_DATASET_XFER );
+#if HAVE_MPI && defined(H5_HAVE_PARALLEL)
+      if( gridView_.comm().size() > 1 )
+        VTK::checkHDF5( H5Pset_dxpl_mpio( transfer, H5FD_MPIO_COLLECTIVE ), "setting up collective transfer" );
+#endif // #if HAVE_MPI && defined(H5_HAVE_PARALLEL)
+      return transfer;
+    }
+
+    hid_t createRoot ( hid_t file ) const
+    {
+      hid_t root = H5Gcreate2( file, "VTKHDF", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT );
+      if( root < 0 )
+        return root;
+
+      const std::array< int, 2 > version = {{ 2, 0 }};
+      writeAttribute( root, "Version", H5T_NATIVE_INT, H5T_STD_I32LE, version.data(), 2 );
+
+      const std::string type = "UnstructuredGrid";
+      VTK::HDF5Handle stringType( H5Tcopy( H5T_C_S1 ), H5Tclose, "creating string type" );
+      VTK::checkHDF5( H5Tset_size( stringType, type.size() ), "setting string size" );
+      VTK::checkHDF5( H5Tset_strpad( stringType, H5T_STR_NULLPAD ), "setting string padding" );
+      writeAttribute( root, "Type", stringType, stringType, type.data(), 0 );
+      return root;
+    }
+
+    // write an attribute (a scalar if count is 0)
+    static void writeAttribute ( hid_t location, const char *name, hid_t memType, hid_t fileType, const void *data, hsize_t count )
+    {
+      if( H5Aexists( location, name ) > 0 )
+        VTK::checkHDF5( H5Adelete( location, name ), std::string( "deleting attribute " ) + name );
+      VTK::HDF5Handle space( count > 0 ? H5Screate_simple( 1, &count, nullptr ) : H5Screate( H5S_SCALAR ), H5Sclose, "creating data space" );
+      VTK::HDF5Handle attribute( H5Acreate2( location, name, fileType, space, H5P_DEFAULT, H5P_DEFAULT ), H5Aclose, std::string( "creating attribute " ) + name );
+      VTK::checkHDF5( H5Awrite( attribute, memType, data ), std::string( "writing attribute " ) + name );
+    }
+
+    // return the slab of this process, given the local number of rows
+    Slab slab ( hsize_t count ) const
+    {
+      const auto &comm = gridView_.comm();
+      std::vector< unsigned long long > counts( comm.size() );
+      unsigned long long local = count;
+      comm.allgather( &local, 1, counts.data() );
+
+      Slab slab;
+      slab.count = count;
+      for( int p = 0; p < comm.size(); ++p )
+      {
+        slab.offset += (p < comm.rank() ? counts[ p ] : 0);
+        slab.size += counts[ p ];
+      }
+      return slab;
+    }
+
+    // slab of a single row written by rank 0
+    static Slab rootSlab ( bool master )
+    {
+      Slab slab;
+      slab.count = (master ? 1 : 0);
+      slab.size = 1;
+      return slab;
+    }
+
+    /* append the rows of all processes to an extendible data set (created if necessary)
+     * and return the number of rows stored before
+     */
+    hsize_t append ( hid_t location, const char *name, hid_t memType, hid_t fileType,
+                     const void *data, const Slab &slab, hsize_t components ) const
+    {
+      const int rank = (components > 0 ? 2 : 1);
+      if( H5Lexists( location, name, H5P_DEFAULT ) <= 0 )
+      {
+        const hsize_t dims[ 2 ] = { 0, components };
+        const hsize_t maxDims[ 2 ] = { H5S_UNLIMITED, components };
+        const hsize_t chunk[ 2 ] = { std::max( std::min( slab.size, hsize_t( 1 ) << 16 ), hsize_t( 1 ) ), std::max( components, hsize_t( 1 ) ) };
+        VTK::HDF5Handle space( H5Screate_simple( rank, dims, maxDims ), H5Sclose, "creating data space" );
+        VTK::HDF5Handle properties( H5Pcreate( H5P_DATASET_CREATE ), H5Pclose, "creating data set properties" );
+        VTK::checkHDF5( H5Pset_chunk( properties, rank, chunk ), "setting chunk size" );
+        VTK::HDF5Handle dataSet( H5Dcreate2( location, name, fileType, space, H5P_DEFAULT, properties, H5P_DEFAULT ), H5Dclose, std::string( "creating data set " ) + name );
+      }
+
+      VTK::HDF5Handle dataSet( H5Dopen2( location, name, H5P_DEFAULT ), H5Dclose, std::string( "opening data set " ) + name );
+      hsize_t dims[ 2 ] = { 0, components };
+      {
+        VTK::HDF5Handle space( H5Dget_space( dataSet ), H5Sclose, "obtaining data space" );
+        H5Sget_simple_extent_dims( space, dims, nullptr );
+      }
+      const hsize_t before = dims[ 0 ];
+      if( slab.size == 0 )
+        return before;
+
+      dims[ 0 ] = before + slab.size;
+      VTK::checkHDF5( H5Dset_extent( dataSet, dims ), std::string( "extending data set " ) + name );
+
+      VTK::HDF5Handle fileSpace( H5Dget_space( dataSet ), H5Sclose, "obtaining data space" );
+      const hsize_t start[ 2 ] = { before + slab.offset, 0 };
+      const hsize_t count[ 2 ] = { slab.count, components };
+      const hsize_t memCount = slab.count * std::max( components, hsize_t( 1 ) );
+      VTK::HDF5Handle memSpace( H5Screate_simple( 1, &memCount, nullptr ), H5Sclose, "creating memory space" );
+      if( slab.count > 0 )
+        VTK::checkHDF5( H5Sselect_hyperslab( fileSpace, H5S_SELECT_SET, start, nullptr, count, nullptr ), "selecting hyperslab" );
+      else
+      {
+        H5Sselect_none( fileSpace );
+        H5Sselect_none( memSpace );
+      }
+
+      VTK::HDF5Handle properties( transfer(), H5Pclose, "creating transfer properties" );
+      VTK::checkHDF5( H5Dwrite( dataSet, memType, memSpace, fileSpace, properties, data ), std::string( "writing data set " ) + name );
+      return before;
+    }
+
+    // append one 64 bit integer written by rank 0
+    void append ( hid_t location, const char *name, std::int64_t value, bool master ) const
+    {
+      append( location, name, H5T_NATIVE_INT64, H5T_STD_I64LE, &value, rootSlab( master ), 0 );
+    }
+
+    // write the grid part of this process and return the offsets of the new piece
+    Piece writeGrid ( hid_t root ) const
+    {
+      const auto &topology = Base::topology();
+
+      Piece piece;
+      piece.numberOfParts = gridView_.comm().size();
+
+      // number of points, cells and connectivity ids of each part
+      const Slab part = slab( 1 );
+      const std::int64_t numberOfPoints = nvertices, numberOfCells = ncells, numberOfIds = ncorners;
+      piece.partOffset = append( root, "NumberOfPoints", H5T_NATIVE_INT64, H5T_STD_I64LE, &numberOfPoints, part, 0 );
+      append( root, "NumberOfCells", H5T_NATIVE_INT64, H5T_STD_I64LE, &numberOfCells, part, 0 );
+      append( root, "NumberOfConnectivityIds", H5T_NATIVE_INT64, H5T_STD_I64LE, &numberOfIds, part, 0 );
+
+      const hid_t coordType = (this->coordPrecision() == VTK::Precision::float64 ? H5T_IEEE_F64LE : H5T_IEEE_F32LE);
+      piece.pointOffset = append( root, "Points", H5T_NATIVE_DOUBLE, coordType, topology.coordinates.data(), slab( nvertices ), 3 );
+
+      // each part stores ncells+1 offsets starting with 0
+      std::vector< std::int64_t > offsets( 1, 0 );
+      offsets.insert( offsets.end(), topology.offsets.begin(), topology.offsets.end() );
+      append( root, "Offsets", H5T_NATIVE_INT64, H5T_STD_I64LE, offsets.data(), slab( offsets.size() ), 0 );
+
+      piece.connectivityOffset = append( root, "Connectivity", H5T_NATIVE_INT64, H5T_STD_I64LE, topology.connectivity.data(), slab( topology.connectivity.size() ), 0 );
+
+      piece.cellOffset = append( root, "Types", H5T_NATIVE_UINT8, H5T_STD_U8LE, topology.types.data(), slab( topology.types.size() ), 0 );
+      return piece;
+    }
+
+    // write grid and data of a file without time steps
+    void writePiece ( hid_t root ) const
+    {
+      writeGrid( root );
+      writeData( root, -1, "PointData", nullptr, vertexdata, Base::staging().vertexValues, Base::staging().vertexComponents, nvertices );
+      writeData( root, -1, "CellData", nullptr, celldata, Base::staging().cellValues, Base::staging().cellComponents, ncells );
+    }
+
+    /* append the values of the functions gathered by the writer, recording the offsets
+     * of the new values in the group offsetsName of steps (if given)
+     */
+    template< class Data >
+    void writeData ( hid_t root, hid_t steps, const char *groupName, const char *offsetsName,
+                     const Data &data, const std::vector< std::vector< double > > &values,
+                     const std::vector< std::size_t > &writecomps, int nentries ) const
+    {
+      if( data.empty() )
+        return;
+
+      const bool create = (H5Lexists( root, groupName, H5P_DEFAULT ) <= 0);
+      VTK::HDF5Handle group( create ? H5Gcreate2( root, groupName, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT ) : H5Gopen2( root, groupName, H5P_DEFAULT ),
+                             H5Gclose, std::string( "opening group " ) + groupName );
+
+      std::size_t k = 0;
+      for( const auto &f : data )
+      {
+        const VTK::FieldInfo fieldInfo = f.fieldInfo();
+        const hsize_t components = (writecomps[ k ] > 1 ? writecomps[ k ] : 0);
+        // the values are staged as double, HDF5 converts them to the type of the field
+        const hsize_t offset = append( group, f.name().c_str(), H5T_NATIVE_DOUBLE, VTK::hdf5FileType( fieldInfo.precision() ), values[ k ].data(), slab( nentries ), components );
+        ++k;
+
+        if( offsetsName )
+        {
+          const bool createOffsets = (H5Lexists( steps, offsetsName, H5P_DEFAULT ) <= 0);
+          VTK::HDF5Handle offsets( createOffsets ? H5Gcreate2( steps, offsetsName, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT ) : H5Gopen2( steps, offsetsName, H5P_DEFAULT ),
+                                   H5Gclose, std::string( "opening group " ) + offsetsName );
+          append( offsets, f.name().c_str(), std::int64_t( offset ), gridView_.comm().rank() == 0 );
+        }
+      }
+    }
+
+    std::string timeSeries_;
+    int nSteps_ = 0;
+    Piece piece_;
+  };
+
+} // namespace Dune
+
+#endif // #if HAVE_HDF5
+
+#endif // #ifndef DUNE_GRID_IO_FILE_VTK_VTKHDFWRITER_HH
@@ -100,6 +100,26 @@ namespace Dune {
     }
 
 
+    /**
+     * \brief Reuse the grid topology for all time steps until gridChanged() is called
+     *
+     * The vertex numbering, the coordinates and the connectivity are then computed
+     * for the first time step only and each following step only evaluates the
+     * data fields. See VTKWriter::reuseTopology().
+     */
+    void reuseTopology (bool reuse = true)
+    {
+      vtkWriter_->reuseTopology(reuse);
+    }
+
+    /**
+     * \brief Notify the writer that the grid or its geometry changed since the last time step
+     */
+    void gridChanged ()
+    {
+      vtkWriter_->topologyChanged();
+    }
+
     /**
      * \brief Writes VTK data for the given time,
      * \param time The time(step) for the data to be written.
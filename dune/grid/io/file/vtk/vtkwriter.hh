@@ -6,18 +6,22 @@
 #ifndef DUNE_VTKWRITER_HH
 #define DUNE_VTKWRITER_HH
 
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <iostream>
 #include <string>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
+#include <limits>
 #include <memory>
 #include <type_traits>
 #include <vector>
 #include <list>
 #include <map>
 
+#include <dune/common/deprecated.hh>
 #include <dune/common/visibility.hh>
 #include <dune/common/typetraits.hh>
 #include <dune/common/exceptions.hh>
@@ -547,10 +551,10 @@ namespace Dune
       // in conforming mode, for each vertex id (as obtained by vertexmapper)
       // hold its number in the iteration order of VertexIterator (*not*
       // CornerIterator)
-      const std::vector<int> & number;
+      const std::vector<std::int64_t> & number;
       // holds the number of corners of all the elements we have seen so far,
       // excluding the current element
-      int offset;
+      std::int64_t offset;
 
       // hide operator ->
       void operator->();
@@ -559,7 +563,7 @@ namespace Dune
                      const GridCellIterator & end,
                      const VTK::DataMode & dm,
                      const VertexMapper & vm,
-                     const std::vector<int> & num) :
+                     const std::vector<std::int64_t> & num) :
         git(x), gend(end), datamode(dm), cornerIndexVTK(0),
         vertexmapper(vm),
         number(num), offset(0) {}
@@ -594,7 +598,7 @@ namespace Dune
        * This method returns the number of this corners associated vertex, in
        * the numbering given by the iteration order of VertexIterator.
        */
-      int id () const
+      std::int64_t id () const
       {
         switch (datamode)
         {
@@ -782,6 +786,41 @@ namespace Dune
     VTK::Precision coordPrecision() const
     { return coordPrec; }
 
+    /** \brief always write 64 bit connectivity, offsets and binary block headers
+     *
+     *  By default, the connectivity and the offsets are written as Int64 only if the
+     *  number of corners exceeds the range of Int32, and the byte counts heading
+     *  binary data blocks are written as UInt64 (header_type="UInt64") only if this
+     *  is the case or an array exceeds 4GiB. Forcing 64 bit output gives files of the
+     *  same layout regardless of their size.
+     */
+    void force64BitIndices ( bool force = true )
+    {
+      force64BitIndices_ = force;
+    }
+
+    /** \brief keep the grid topology between calls to write
+     *
+     *  If enabled, the vertex numbering, the point coordinates and the connectivity
+     *  are computed by the first write and reused by the following ones, so that only
+     *  the data fields are evaluated for each file. This pays off for time series on
+     *  a static grid. Call topologyChanged() whenever the grid or its geometry
+     *  changes; a change of the number of cells or vertices is detected automatically.
+     */
+    void reuseTopology ( bool reuse = true )
+    {
+      reuseTopology_ = reuse;
+      topologyChanged();
+    }
+
+    //! discard the topology kept by reuseTopology()
+    void topologyChanged ()
+    {
+      vertexmapper.reset();
+      number.clear();
+      topology_ = Topology();
+    }
+
     //! destructor
     virtual ~VTKWriter ()
     {
@@ -1176,16 +1215,10 @@ namespace Dune
       VTK::FileType fileType =
         (n == 1) ? VTK::polyData : VTK::unstructuredGrid;
 
-      VTK::VTUWriter writer(s, outputtype, fileType);
+      // Grid characteristics and data
+      prepareData();
 
-      // Grid characteristics
-      vertexmapper = new VertexMapper( gridView_, mcmgVertexLayout() );
-      if (datamode == VTK::conforming)
-      {
-        number.resize(vertexmapper->size());
-        for (std::vector<int>::size_type i=0; i<number.size(); i++) number[i] = -1;
-      }
-      countEntities(nvertices, ncells, ncorners);
+      VTK::VTUWriter writer(s, outputtype, fileType, headerPrecision());
 
       writer.beginMain(ncells, nvertices);
       writeAllData(writer);
@@ -1196,7 +1229,7 @@ namespace Dune
         writeAllData(writer);
       writer.endAppended();
 
-      delete vertexmapper; number.clear();
+      releaseTopology();
     }
 
     void writeAllData(VTK::VTUWriter& writer) {
@@ -1235,33 +1268,236 @@ namespace Dune
         return "UnstructuredGrid";
     }
 
-    //! count the vertices, cells and corners
-    virtual void countEntities(int &nvertices_, int &ncells_, int &ncorners_)
+    /** \brief gather the grid and all data of the next file in a single grid traversal
+     *
+     *  Each cell is visited once: its cell data, the vertex data at its corners visited
+     *  first, the coordinates and the connectivity are stored in staging buffers, from
+     *  which all arrays are written (also the appended section, without traversing the
+     *  grid again). If the topology kept by reuseTopology() is up to date, only the
+     *  data is evaluated.
+     *
+     *  Derived writers producing a different topology override this method, filling
+     *  topology_ and staging_ themselves (see beginStaging()).
+     *
+     *  \returns true if the topology was recomputed, false if the kept one is used
+     */
+    virtual bool gatherData ()
     {
-      nvertices_ = 0;
-      ncells_ = 0;
-      ncorners_ = 0;
+      const bool topology = !topologyUpToDate();
+      if (topology)
+      {
+        topologyChanged();
+        vertexmapper = std::make_shared<VertexMapper>( gridView_, mcmgVertexLayout() );
+        if (datamode == VTK::conforming)
+          number.assign(vertexmapper->size(), -1);
+        ncells = nvertices = ncorners = 0;
+      }
+
+      std::vector<VTK::VectorDataArrayWriter> cellWriters, vertexWriters;
+      beginStaging(cellWriters, vertexWriters);
+
+      // in conforming mode, the vertices are written for the first cell containing them
+      std::vector<bool> visited(datamode == VTK::conforming ? vertexmapper->size() : 0, false);
+      std::vector<std::int64_t> localNumber;
+      std::int64_t offset = 0;
       for (CellIterator it=cellBegin(); it!=cellEnd(); ++it)
       {
-        ncells_++;
-        // because of the use of vertexmapper->map(), this iteration must be
-        // in the order of Dune's numbering.
-        const int subEntities = it->subEntities(n);
-        for (int i=0; i<subEntities; ++i)
+        const Entity& e = *it;
+        const int corners = e.subEntities(n);
+
+        std::size_t k = 0;
+        for (const auto& f : celldata)
         {
-          ncorners_++;
+          f.bind(e);
+          f.write(it.position(), cellWriters[k]);
+          f.unbind();
+          pad(f.fieldInfo(), staging_.cellComponents[k], cellWriters[k]);
+          ++k;
+        }
+
+        for (const auto& f : vertexdata)
+          f.bind(e);
+        const auto refElement = referenceElement<DT,n>(e.type());
+        localNumber.resize(corners);
+        for (int i=0; i<corners; ++i)
+        {
+          bool first = true;
           if (datamode == VTK::conforming)
           {
-            int alpha = vertexmapper->subIndex(*it,i,n);
-            if (number[alpha]<0)
-              number[alpha] = nvertices_++;
+            const auto alpha = vertexmapper->subIndex(e,i,n);
+            first = !visited[alpha];
+            visited[alpha] = true;
+            if (topology && first)
+              number[alpha] = nvertices++;
+            localNumber[i] = number[alpha];
           }
           else
           {
-            nvertices_++;
+            localNumber[i] = offset + i;
+            if (topology)
+              ++nvertices;
+          }
+          if (!first)
+            continue;
+
+          k = 0;
+          for (const auto& f : vertexdata)
+          {
+            f.write(refElement.position(i,n), vertexWriters[k]);
+            pad(f.fieldInfo(), staging_.vertexComponents[k], vertexWriters[k]);
+            ++k;
+          }
+
+          if (topology)
+          {
+            const auto corner = e.geometry().corner(i);
+            for (int j=0; j<3; j++)
+              topology_.coordinates.push_back(j < std::min(int(w),3) ? double(corner[j]) : 0.0);
           }
         }
+        for (const auto& f : vertexdata)
+          f.unbind();
+
+        if (topology)
+        {
+          ++ncells;
+          ncorners += corners;
+          for (int j=0; j<corners; ++j)
+            topology_.connectivity.push_back(localNumber[VTK::renumber(e,j)]);
+          topology_.offsets.push_back(offset + corners);
+          topology_.types.push_back(VTK::geometryType(e.type()));
+        }
+        offset += corners;
+      }
+
+      if (topology)
+      {
+        topology_.gridCells = gridView_.size(0);
+        topology_.gridVertices = gridView_.size(n);
+        topology_.valid = true;
+      }
+      staging_.valid = true;
+      return topology;
+    }
+
+    /** \brief count the vertices, cells and corners
+     *
+     *  \deprecated The counts are computed by gatherData(), which supersedes this method.
+     *  It is no longer called to determine the counts; the default implementation returns
+     *  those of the last call to gatherData(), and prepareData() throws if an override
+     *  returns different ones.
+     */
+    [[deprecated("Override gatherData() instead. countEntities() will be removed after release 2.11")]]
+    virtual void countEntities(int &nvertices_, int &ncells_, int &ncorners_)
+    {
+      nvertices_ = nvertices;
+      ncells_ = ncells;
+      ncorners_ = ncorners;
+    }
+
+    /** \brief gather the data of the next file, see gatherData()
+     *
+     *  Derived writers still overriding the deprecated countEntities() would write counts
+     *  that do not match the gathered arrays, so they are rejected here.
+     *
+     *  \returns true if the topology was recomputed, false if the kept one is used
+     */
+    bool prepareData ()
+    {
+      const bool topology = gatherData();
+      if (topology)
+      {
+        int nvertices_, ncells_, ncorners_;
+        DUNE_NO_DEPRECATED_BEGIN
+        countEntities(nvertices_, ncells_, ncorners_);
+        DUNE_NO_DEPRECATED_END
+        if (nvertices_ != int(nvertices) || ncells_ != int(ncells) || ncorners_ != int(ncorners))
+          DUNE_THROW(NotImplemented, "VTKWriter: countEntities() is deprecated and no longer used, derived writers have to override gatherData()");
       }
+      return topology;
+    }
+
+    //! reset the staging buffers and create a writer into them for each function
+    void beginStaging (std::vector<VTK::VectorDataArrayWriter>& cellWriters,
+                       std::vector<VTK::VectorDataArrayWriter>& vertexWriters)
+    {
+      staging_ = Staging();
+      staging_.cellValues.resize(celldata.size());
+      staging_.vertexValues.resize(vertexdata.size());
+      cellWriters.clear();
+      vertexWriters.clear();
+      cellWriters.reserve(celldata.size());
+      vertexWriters.reserve(vertexdata.size());
+      for (const auto& f : celldata)
+      {
+        staging_.cellComponents.push_back(writeComponents(f.fieldInfo()));
+        cellWriters.emplace_back(staging_.cellValues[cellWriters.size()]);
+      }
+      for (const auto& f : vertexdata)
+      {
+        staging_.vertexComponents.push_back(writeComponents(f.fieldInfo()));
+        vertexWriters.emplace_back(staging_.vertexValues[vertexWriters.size()]);
+      }
+    }
+
+    //! release the data of a written file, keeping the topology if it is reused
+    void releaseTopology ()
+    {
+      staging_ = Staging();
+      if (!reuseTopology_)
+        topologyChanged();
+    }
+
+    //! return true if the topology kept by reuseTopology() can be used for the next file
+    bool topologyUpToDate () const
+    {
+      return reuseTopology_ && topology_.valid
+             && (topology_.gridCells == gridView_.size(0))
+             && (topology_.gridVertices == gridView_.size(n));
+    }
+
+    //! number of components written for a field; vectors are padded to three components
+    static std::size_t writeComponents (const VTK::FieldInfo& fieldInfo)
+    {
+      switch (fieldInfo.type())
+        {
+        case VTK::FieldInfo::Type::scalar:
+          return fieldInfo.size();
+        case VTK::FieldInfo::Type::vector:
+          if (fieldInfo.size() > 3)
+            DUNE_THROW(IOError,"Cannot write VTK vectors with more than 3 components (components was " << fieldInfo.size() << ")");
+          return 3;
+        case VTK::FieldInfo::Type::tensor:
+          DUNE_THROW(NotImplemented,"VTK output for tensors not implemented yet");
+        }
+      return fieldInfo.size();
+    }
+
+    //! precision of the connectivity and the offsets, depending on the entity counts
+    VTK::Precision indexPrecision () const
+    {
+      const std::size_t maxInt32 = std::numeric_limits<std::int32_t>::max();
+      return (force64BitIndices_ || ncorners > maxInt32) ? VTK::Precision::int64 : VTK::Precision::int32;
+    }
+
+    //! type of the byte counts heading binary data blocks, depending on the largest array
+    VTK::Precision headerPrecision () const
+    {
+      if (indexPrecision() == VTK::Precision::int64)
+        return VTK::Precision::uint64;
+
+      std::uint64_t bytes = std::max(3*nvertices*VTK::typeSize(coordPrec), ncorners*VTK::typeSize(VTK::Precision::int32));
+      for (const auto& f : celldata)
+        bytes = std::max<std::uint64_t>(bytes, ncells*writeComponents(f.fieldInfo())*VTK::typeSize(f.fieldInfo().precision()));
+      for (const auto& f : vertexdata)
+        bytes = std::max<std::uint64_t>(bytes, nvertices*writeComponents(f.fieldInfo())*VTK::typeSize(f.fieldInfo().precision()));
+      return (bytes > std::numeric_limits<std::uint32_t>::max()) ? VTK::Precision::uint64 : VTK::Precision::uint32;
+    }
+
+    static void pad (const VTK::FieldInfo& fieldInfo, std::size_t writecomps, VTK::DataArrayWriter& writer)
+    {
+      for (std::size_t j=fieldInfo.size(); j < writecomps; ++j)
+        writer.write(0.0);
     }
 
     template<typename T>
@@ -1333,6 +1569,23 @@ namespace Dune
       }
     }
 
+    //! write the staged values of the functions
+    void writeStagedData(VTK::VTUWriter& writer, const std::list<VTKLocalFunction>& data,
+                         const std::vector<std::vector<double> >& values,
+                         const std::vector<std::size_t>& components, int nentries)
+    {
+      std::size_t k = 0;
+      for (const auto& f : data)
+      {
+        std::shared_ptr<VTK::DataArrayWriter> p
+          (writer.makeArrayWriter(f.name(), components[k], nentries, f.fieldInfo().precision()));
+        if(!p->writeIsNoop())
+          for (double value : values[k])
+            p->write(value);
+        ++k;
+      }
+    }
+
     //! write cell data
     virtual void writeCellData(VTK::VTUWriter& writer)
     {
@@ -1343,7 +1596,10 @@ namespace Dune
       std::tie(scalars,vectors) = getDataNames(celldata);
 
       writer.beginCellData(scalars, vectors);
-      writeData(writer,celldata,cellBegin(),cellEnd(),ncells);
+      if (staging_.valid)
+        writeStagedData(writer,celldata,staging_.cellValues,staging_.cellComponents,ncells);
+      else
+        writeData(writer,celldata,cellBegin(),cellEnd(),ncells);
       writer.endCellData();
     }
 
@@ -1357,7 +1613,10 @@ namespace Dune
       std::tie(scalars,vectors) = getDataNames(vertexdata);
 
       writer.beginPointData(scalars, vectors);
-      writeData(writer,vertexdata,vertexBegin(),vertexEnd(),nvertices);
+      if (staging_.valid)
+        writeStagedData(writer,vertexdata,staging_.vertexValues,staging_.vertexComponents,nvertices);
+      else
+        writeData(writer,vertexdata,vertexBegin(),vertexEnd(),nvertices);
       writer.endPointData();
     }
 
@@ -1368,7 +1627,11 @@ namespace Dune
 
       std::shared_ptr<VTK::DataArrayWriter> p
         (writer.makeArrayWriter("Coordinates", 3, nvertices, coordPrec));
-      if(!p->writeIsNoop()) {
+      if(!p->writeIsNoop() && topology_.valid) {
+        for (double x : topology_.coordinates)
+          p->write(x);
+      }
+      else if(!p->writeIsNoop()) {
         VertexIterator vEnd = vertexEnd();
         for (VertexIterator vit=vertexBegin(); vit!=vEnd; ++vit)
         {
@@ -1393,8 +1656,11 @@ namespace Dune
       // connectivity
       {
         std::shared_ptr<VTK::DataArrayWriter> p1
-          (writer.makeArrayWriter("connectivity", 1, ncorners, VTK::Precision::int32));
-        if(!p1->writeIsNoop())
+          (writer.makeArrayWriter("connectivity", 1, ncorners, indexPrecision()));
+        if(!p1->writeIsNoop() && topology_.valid)
+          for (std::int64_t id : topology_.connectivity)
+            p1->write(id);
+        else if(!p1->writeIsNoop())
           for (CornerIterator it=cornerBegin(); it!=cornerEnd(); ++it)
             p1->write(it.id());
       }
@@ -1402,9 +1668,13 @@ namespace Dune
       // offsets
       {
         std::shared_ptr<VTK::DataArrayWriter> p2
-          (writer.makeArrayWriter("offsets", 1, ncells, VTK::Precision::int32));
-        if(!p2->writeIsNoop()) {
-          int offset = 0;
+          (writer.makeArrayWriter("offsets", 1, ncells, indexPrecision()));
+        if(!p2->writeIsNoop() && topology_.valid) {
+          for (std::int64_t offset : topology_.offsets)
+            p2->write(offset);
+        }
+        else if(!p2->writeIsNoop()) {
+          std::int64_t offset = 0;
           for (CellIterator it=cellBegin(); it!=cellEnd(); ++it)
           {
             offset += it->subEntities(n);
@@ -1420,7 +1690,12 @@ namespace Dune
           std::shared_ptr<VTK::DataArrayWriter> p3
             (writer.makeArrayWriter("types", 1, ncells, VTK::Precision::uint8));
 
-          if(!p3->writeIsNoop())
+          if(!p3->writeIsNoop() && topology_.valid)
+          {
+            for (int vtktype : topology_.types)
+              p3->write(vtktype);
+          }
+          else if(!p3->writeIsNoop())
           {
             for (CellIterator it=cellBegin(); it!=cellEnd(); ++it)
             {
@@ -1468,7 +1743,7 @@ namespace Dune
 
       std::vector< int >& faces = faceVertices_->first;
       std::vector< int >& faceOffsets = faceVertices_->second;
-      assert( int(faceOffsets.size()) == ncells );
+      assert( faceOffsets.size() == ncells );
 
       {
         std::shared_ptr<VTK::DataArrayWriter> p4
@@ -1592,20 +1867,56 @@ namespace Dune
     GridView gridView_;
 
     // temporary grid information
-    int ncells;
-    int nvertices;
-    int ncorners;
+    std::size_t ncells;
+    std::size_t nvertices;
+    std::size_t ncorners;
+
+    // topology kept between writes, see reuseTopology() and gatherData()
+    struct Topology
+    {
+      bool valid = false;
+      int gridCells = 0;
+      int gridVertices = 0;
+      std::vector<double> coordinates;
+      std::vector<std::int64_t> connectivity;
+      std::vector<std::int64_t> offsets;
+      std::vector<std::uint8_t> types;
+    };
+
+    //! topology arrays stored by the last call to gatherData()
+    const Topology &topology () const { return topology_; }
+
+    Topology topology_;
+
+    // values of the functions gathered for a file, see gatherData()
+    struct Staging
+    {
+      bool valid = false;
+      std::vector<std::vector<double> > cellValues;
+      std::vector<std::vector<double> > vertexValues;
+      std::vector<std::size_t> cellComponents;
+      std::vector<std::size_t> vertexComponents;
+    };
+
+    //! function values stored by the last call to gatherData()
+    const Staging &staging () const { return staging_; }
+
+    Staging staging_;
+
   private:
-    VertexMapper* vertexmapper;
+    std::shared_ptr<VertexMapper> vertexmapper;
     // in conforming mode, for each vertex id (as obtained by vertexmapper)
     // hold its number in the iteration order (VertexIterator)
-    std::vector<int> number;
+    std::vector<std::int64_t> number;
     VTK::DataMode datamode;
     VTK::Precision coordPrec;
 
     // true if polyhedral cells are present in the grid
     const bool polyhedralCellsPresent_;
 
+    bool reuseTopology_ = false;
+    bool force64BitIndices_ = false;
+
     // pointer holding face vertex connectivity if needed
     std::shared_ptr< std::pair< std::vector<int>, std::vector<int> > > faceVertices_;
 
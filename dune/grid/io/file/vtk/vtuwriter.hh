@@ -6,6 +6,7 @@
 #ifndef DUNE_GRID_IO_FILE_VTK_VTUWRITER_HH
 #define DUNE_GRID_IO_FILE_VTK_VTUWRITER_HH
 
+#include <cstddef>
 #include <ostream>
 #include <string>
 
@@ -116,12 +117,16 @@ namespace Dune {
        * \param outputType How to encode data.
        * \param fileType_  Whether to write PolyData (1D) or UnstructuredGrid
        *                   (nD) format.
+       * \param headerType Type of the byte counts heading binary data blocks,
+       *                   Precision::uint32 or Precision::uint64.  UInt64 is
+       *                   needed for arrays larger than 4GiB.
        *
        * Create object and write header.
        */
       inline VTUWriter(std::ostream& stream_, OutputType outputType,
-                       FileType fileType_)
-        : stream(stream_), factory(outputType, stream)
+                       FileType fileType_,
+                       Precision headerType = Precision::uint32)
+        : stream(stream_), factory(outputType, stream, headerType)
       {
         switch(fileType_) {
         case polyData :
@@ -141,7 +146,12 @@ namespace Dune {
         stream << indent << "<VTKFile"
                << " type=\"" << fileType << "\""
                << " version=\"0.1\""
-               << " byte_order=\"" << byteOrder << "\">\n";
+               << " byte_order=\"" << byteOrder << "\"";
+        if(headerType == Precision::uint64)
+          stream << " header_type=\"UInt64\"";
+        else if(headerType != Precision::uint32)
+          DUNE_THROW(IOError, "VTUWriter: unsupported header type " << toString(headerType));
+        stream << ">\n";
         ++indent;
       }
 
@@ -262,11 +272,11 @@ namespace Dune {
        * Between the call to this method an the following call to the
        * endCells(), there must be two or three fields written:
        * <ul>
-       * <li>"connectivity" of type Int32 with 3 components, number of items
-       *     is the number of corners (that may be different from number of
-       *     vertices!)
-       * <li>"offsets" of type Int32 with one component, number of items is
-       *     number of cells.
+       * <li>"connectivity" of type Int32 or Int64 with 3 components, number of
+       *     items is the number of corners (that may be different from number
+       *     of vertices!)
+       * <li>"offsets" of type Int32 or Int64 with one component, number of
+       *     items is number of cells.
        * <li>for UnstructuredGrid, "types" of type UInt8 with one component,
        *     number of items is number of cells.
        * </ul>
@@ -307,7 +317,7 @@ namespace Dune {
        * <li> beginCells()/endCells(),
        * </ul>
        */
-      inline void beginMain(unsigned ncells, unsigned npoints) {
+      inline void beginMain(std::size_t ncells, std::size_t npoints) {
         stream << indent << "<" << fileType << ">\n";
         ++indent;
         stream << indent << "<Piece"
@@ -378,7 +388,7 @@ namespace Dune {
        * delete.
        */
       DataArrayWriter* makeArrayWriter(const std::string& name,
-                                       unsigned ncomps, unsigned nitems,
+                                       unsigned ncomps, std::size_t nitems,
                                        Precision prec) {
         return factory.make(name, ncomps, nitems, indent, prec);
       }
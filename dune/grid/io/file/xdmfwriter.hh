@@ -0,0 +1,426 @@
+// SPDX-FileCopyrightText: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_IO_FILE_XDMFWRITER_HH
+#define DUNE_GRID_IO_FILE_XDMFWRITER_HH
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+
+#include <dune/grid/io/file/vtk/common.hh>
+#include <dune/grid/io/file/vtk/vtkwriter.hh>
+
+#if HAVE_MPI
+#include <mpi.h>
+#endif // #if HAVE_MPI
+
+/** @file
+    @author DUNE Project contributors
+    @brief Provides a writer for XDMF descriptors with raw binary data
+ */
+
+namespace Dune
+{
+
+  /**
+   * @brief Writer for the XDMF format with raw binary heavy data
+   * @ingroup VTK
+   *
+   * Writes the grid and the registered cell and vertex data as raw binary arrays
+   * in the byte order of the machine, together with a small XDMF (version 3)
+   * descriptor <tt>name.xmf</tt> which can be read by ParaView and VisIt. Contrary
+   * to the VTK XML formats, the data is neither encoded nor interleaved with XML.
+   *
+   * The heavy data is written into one file per process (<tt>name-p0000.bin</tt>,
+   * ...) or, if aggregate is set and the grid uses MPI, into a single file
+   * <tt>name.bin</tt> using collective MPI-IO. Each array is written with a single
+   * large write call. In serial, the data is always written to <tt>name.bin</tt>.
+   *
+   * Functions are registered through the interface of VTKWriter.
+   *
+   * \tparam GridView Grid view of the grid we are writing
+   */
+  template< class GridView >
+  class XdmfWriter
+    : public VTKWriter< GridView >
+  {
+    typedef VTKWriter< GridView > Base;
+
+    using Base::celldata;
+    using Base::vertexdata;
+    using Base::gridView_;
+    using Base::ncells;
+    using Base::nvertices;
+
+    // description of an array; the same on all processes
+    struct Array
+    {
+      enum Kind { topology, geometry, cell, vertex };
+
+      std::string name;
+      Kind kind;
+      std::size_t components;
+      VTK::Precision precision;
+    };
+
+    // sizes of the part of a process
+    struct Part
+    {
+      unsigned long long cells = 0;
+      unsigned long long vertices = 0;
+      unsigned long long topology = 0;
+    };
+
+  public:
+    /**
+     * @brief Construct an XdmfWriter working on a specific GridView.
+     *
+     * @param gridView The gridView the grid functions live on.
+     * @param dm The data mode.
+     * @param coordPrecision the precision with which to write out the coordinates
+     * @param aggregate write the data of all processes into a single file
+     */
+    explicit XdmfWriter ( const GridView &gridView,
+                          VTK::DataMode dm = VTK::conforming,
+                          VTK::Precision coordPrecision = VTK::Precision::float32,
+                          bool aggregate = false )
+      : Base( gridView, dm, coordPrecision ),
+        aggregate_( aggregate )
+    {}
+
+    /**
+     * @brief write the descriptor name.xmf and the heavy data files
+     *
+     * This method has to be called on all processes.
+     *
+     * \returns the name of the descriptor
+     */
+    std::string write ( const std::string &name )
+    {
+      const auto &comm = gridView_.comm();
+      Base::prepareData();
+
+      // evaluate all arrays of this process
+      std::vector< Array > arrays;
+      std::vector< std::vector< char > > buffers;
+      Part part;
+      part.cells = ncells;
+      part.vertices = nvertices;
+      // all processes write the topology with the same precision, as the descriptor assumes
+      const bool large = comm.max( int( Base::indexPrecision() == VTK::Precision::int64 ) );
+      collect( arrays, buffers, part.topology, large ? VTK::Precision::int64 : VTK::Precision::int32 );
+
+      const unsigned long long local[ 3 ] = { part.cells, part.vertices, part.topology };
+      std::vector< unsigned long long > all( 3*comm.size() );
+      comm.allgather( local, 3, all.data() );
+      std::vector< Part > parts( comm.size() );
+      for( int p = 0; p < comm.size(); ++p )
+        parts[ p ] = Part{ all[ 3*p ], all[ 3*p+1 ], all[ 3*p+2 ] };
+
+      // heavy data files and position of each array
+      std::vector< std::string > files( comm.size() );
+      std::vector< std::vector< unsigned long long > > seeks( comm.size(), std::vector< unsigned long long >( arrays.size() ) );
+      const bool aggregate = (comm.size() == 1) || (aggregate_ && canAggregate());
+      unsigned long long base = 0;
+      for( std::size_t a = 0; a < arrays.size(); ++a )
+      {
+        for( int p = 0; p < comm.size(); ++p )
+        {
+          seeks[ p ][ a ] = (aggregate || (a == 0) ? base : seeks[ p ][ a-1 ] + bytes( arrays[ a-1 ], parts[ p ] ));
+          if( aggregate )
+            base += bytes( arrays[ a ], parts[ p ] );
+        }
+      }
+      for( int p = 0; p < comm.size(); ++p )
+        files[ p ] = (aggregate ? name + ".bin" : partName( name, p ));
+
+      if( aggregate && (comm.size() > 1) )
+        writeAggregated( files[ comm.rank() ], buffers, seeks[ comm.rank() ] );
+      else
+      {
+        std::ofstream out( files[ comm.rank() ], std::ios::binary );
+        if( !out )
+          DUNE_THROW( IOError, "XdmfWriter: could not open " << files[ comm.rank() ] );
+        for( const auto &buffer : buffers )
+          out.write( buffer.data(), buffer.size() );
+        if( !out )
+          DUNE_THROW( IOError, "XdmfWriter: could not write " << files[ comm.rank() ] );
+      }
+
+      Base::releaseTopology();
+
+      const std::string fileName = name + ".xmf";
+      if( comm.rank() == 0 )
+        writeDescriptor( fileName, name, arrays, parts, files, seeks );
+      comm.barrier();
+      return fileName;
+    }
+
+  private:
+    // convert the topology, the geometry and the function values of this process
+    void collect ( std::vector< Array > &arrays, std::vector< std::vector< char > > &buffers,
+                   unsigned long long &topologyLength, VTK::Precision topologyPrecision ) const
+    {
+      const auto &topology = Base::topology();
+
+      // mixed topology: XDMF type, number of corners for poly cells, corners
+      std::vector< std::int64_t > mixed;
+      mixed.reserve( topology.connectivity.size() + 2*topology.types.size() );
+      for( std::size_t i = 0; i < topology.types.size(); ++i )
+      {
+        const std::int64_t begin = (i > 0 ? topology.offsets[ i-1 ] : 0);
+        const std::int64_t end = topology.offsets[ i ];
+        mixed.push_back( xdmfType( VTK::GeometryType( topology.types[ i ] ) ) );
+        if( (topology.types[ i ] == VTK::vertex) || (topology.types[ i ] == VTK::line) || (topology.types[ i ] == VTK::polygon) )
+          mixed.push_back( end - begin );
+        mixed.insert( mixed.end(), topology.connectivity.begin() + begin, topology.connectivity.begin() + end );
+      }
+      topologyLength = mixed.size();
+      arrays.push_back( Array{ "topology", Array::topology, 1, topologyPrecision } );
+      buffers.push_back( toBytes( mixed, topologyPrecision ) );
+
+      arrays.push_back( Array{ "geometry", Array::geometry, 3, this->coordPrecision() } );
+      buffers.push_back( toBytes( topology.coordinates, this->coordPrecision() ) );
+
+      const auto &staging = Base::staging();
+      std::size_t k = 0;
+      for( const auto &f : vertexdata )
+      {
+        const VTK::Precision precision = f.fieldInfo().precision();
+        arrays.push_back( Array{ f.name(), Array::vertex, staging.vertexComponents[ k ], precision } );
+        buffers.push_back( toBytes( staging.vertexValues[ k ], precision ) );
+        ++k;
+      }
+
+      k = 0;
+      for( const auto &f : celldata )
+      {
+        const VTK::Precision precision = f.fieldInfo().precision();
+        arrays.push_back( Array{ f.name(), Array::cell, staging.cellComponents[ k ], precision } );
+        buffers.push_back( toBytes( staging.cellValues[ k ], precision ) );
+        ++k;
+      }
+    }
+
+    static int xdmfType ( VTK::GeometryType type )
+    {
+      switch( type )
+      {
+      case VTK::vertex :        return 1;
+      case VTK::line :          return 2;
+      case VTK::polygon :       return 3;
+      case VTK::triangle :      return 4;
+      case VTK::quadrilateral : return 5;
+      case VTK::tetrahedron :   return 6;
+      case VTK::pyramid :       return 7;
+      case VTK::prism :         return 8;
+      case VTK::hexahedron :    return 9;
+      default :
+        DUNE_THROW( NotImplemented, "XdmfWriter: unsupported cell type " << type );
+      }
+    }
+
+    // convert the values to the type T and return their raw bytes
+    template< class T, class V >
+    static std::vector< char > toBytes ( const std::vector< V > &values )
+    {
+      const std::vector< T > converted( values.begin(), values.end() );
+      std::vector< char > bytes( converted.size() * sizeof( T ) );
+      std::memcpy( bytes.data(), converted.data(), bytes.size() );
+      return bytes;
+    }
+
+    template< class V >
+    static std::vector< char > toBytes ( const std::vector< V > &values, VTK::Precision precision )
+    {
+      switch( precision )
+      {
+      case VTK::Precision::int32 :   return toBytes< std::int32_t >( values );
+      case VTK::Precision::uint8 :   return toBytes< std::uint8_t >( values );
+      case VTK::Precision::uint32 :  return toBytes< std::uint32_t >( values );
+      case VTK::Precision::float32 : return toBytes< float >( values );
+      case VTK::Precision::float64 : return toBytes< double >( values );
+      case VTK::Precision::int64 :   return toBytes< std::int64_t >( values );
+      case VTK::Precision::uint64 :  return toBytes< std::uint64_t >( values );
+      }
+      DUNE_THROW( NotImplemented, "XdmfWriter: unknown precision" );
+    }
+
+    // XDMF number type of a precision
+    static const char *numberType ( VTK::Precision precision )
+    {
+      switch( precision )
+      {
+      case VTK::Precision::int32 :
+      case VTK::Precision::int64 :
+        return "Int";
+      case VTK::Precision::uint8 :
+        return "UChar";
+      case VTK::Precision::uint32 :
+      case VTK::Precision::uint64 :
+        return "UInt";
+      default :
+        return "Float";
+      }
+    }
+
+    // number of values of an array on a process
+    static unsigned long long size ( const Array &array, const Part &part )
+    {
+      switch( array.kind )
+      {
+      case Array::topology : return part.topology;
+      case Array::geometry : return 3 * part.vertices;
+      case Array::cell :     return array.components * part.cells;
+      case Array::vertex :   return array.components * part.vertices;
+      }
+      return 0;
+    }
+
+    static unsigned long long bytes ( const Array &array, const Part &part )
+    {
+      return size( array, part ) * VTK::typeSize( array.precision );
+    }
+
+    static std::string partName ( const std::string &name, int rank )
+    {
+      std::ostringstream s;
+      s << name << "-p" << std::setw( 4 ) << std::setfill( '0' ) << rank << ".bin";
+      return s.str();
+    }
+
+    // strip the directory of a file name, the descriptor refers to files next to it
+    static std::string baseName ( const std::string &fileName )
+    {
+      const std::size_t pos = fileName.find_last_of( '/' );
+      return (pos == std::string::npos ? fileName : fileName.substr( pos+1 ));
+    }
+
+    bool canAggregate () const
+    {
+#if HAVE_MPI
+      return std::is_convertible_v< std::decay_t< decltype( gridView_.comm() ) >, MPI_Comm >;
+#else // #if HAVE_MPI
+      return false;
+#endif // #else // #if HAVE_MPI
+    }
+
+    // write the arrays of all processes into one file with collective MPI-IO
+    void writeAggregated ( const std::string &fileName, const std::vector< std::vector< char > > &buffers,
+                           const std::vector< unsigned long long > &seeks ) const
+    {
+#if HAVE_MPI
+      if constexpr (std::is_convertible_v< std::decay_t< decltype( gridView_.comm() ) >, MPI_Comm >)
+      {
+        const auto &comm = gridView_.comm();
+        MPI_Comm mpiComm = comm;
+
+        if( comm.rank() == 0 )
+          MPI_File_delete( fileName.c_str(), MPI_INFO_NULL );
+        comm.barrier();
+
+        MPI_File file;
+        if( MPI_File_open( mpiComm, fileName.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &file ) != MPI_SUCCESS )
+          DUNE_THROW( IOError, "XdmfWriter: could not open " << fileName );
+
+        // MPI counts are int, so large arrays are written in several collective calls
+        const unsigned long long chunk = 1ull << 30;
+        for( std::size_t a = 0; a < buffers.size(); ++a )
+        {
+          const unsigned long long total = buffers[ a ].size();
+          const unsigned long long calls = comm.max( (total + chunk - 1) / chunk );
+          for( unsigned long long c = 0; c < calls; ++c )
+          {
+            const unsigned long long begin = std::min( c*chunk, total );
+            const int count = static_cast< int >( std::min( chunk, total - begin ) );
+            if( MPI_File_write_at_all( file, seeks[ a ] + begin, buffers[ a ].data() + begin, count, MPI_BYTE, MPI_STATUS_IGNORE ) != MPI_SUCCESS )
+              DUNE_THROW( IOError, "XdmfWriter: could not write " << fileName );
+          }
+        }
+
+        MPI_File_close( &file );
+        return;
+      }
+#endif // #if HAVE_MPI
+      DUNE_THROW( NotImplemented, "XdmfWriter: aggregated output requires MPI" );
+    }
+
+    static void writeDataItem ( std::ostream &s, const std::string &indent, const std::string &dimensions,
+                                VTK::Precision precision, const std::string &file, unsigned long long seek )
+    {
+      const std::string endian = (VTK::getEndiannessString() == "BigEndian" ? "Big" : "Little");
+      s << indent << "<DataItem Dimensions=\"" << dimensions << "\" NumberType=\"" << numberType( precision )
+        << "\" Precision=\"" << VTK::typeSize( precision ) << "\" Format=\"Binary\" Endian=\"" << endian
+        << "\" Seek=\"" << seek << "\">" << baseName( file ) << "</DataItem>\n";
+    }
+
+    static void writeDescriptor ( const std::string &fileName, const std::string &name,
+                                  const std::vector< Array > &arrays, const std::vector< Part > &parts,
+                                  const std::vector< std::string > &files,
+                                  const std::vector< std::vector< unsigned long long > > &seeks )
+    {
+      std::ofstream s( fileName );
+      if( !s )
+        DUNE_THROW( IOError, "XdmfWriter: could not open " << fileName );
+
+      s << "<?xml version=\"1.0\" ?>\n"
+        << "<Xdmf Version=\"3.0\">\n"
+        << "  <Domain>\n"
+        << "    <Grid Name=\"" << baseName( name ) << "\" GridType=\"Collection\" CollectionType=\"Spatial\">\n";
+      for( std::size_t p = 0; p < parts.size(); ++p )
+      {
+        s << "      <Grid Name=\"part" << p << "\" GridType=\"Uniform\">\n";
+        for( std::size_t a = 0; a < arrays.size(); ++a )
+        {
+          const Array &array = arrays[ a ];
+          const unsigned long long rows = size( array, parts[ p ] ) / array.components;
+          std::ostringstream dimensions;
+          dimensions << rows;
+          if( array.components > 1 )
+            dimensions << " " << array.components;
+
+          switch( array.kind )
+          {
+          case Array::topology :
+            s << "        <Topology TopologyType=\"Mixed\" NumberOfElements=\"" << parts[ p ].cells << "\">\n";
+            writeDataItem( s, "          ", dimensions.str(), array.precision, files[ p ], seeks[ p ][ a ] );
+            s << "        </Topology>\n";
+            break;
+          case Array::geometry :
+            s << "        <Geometry GeometryType=\"XYZ\">\n";
+            writeDataItem( s, "          ", dimensions.str(), array.precision, files[ p ], seeks[ p ][ a ] );
+            s << "        </Geometry>\n";
+            break;
+          case Array::cell :
+          case Array::vertex :
+            s << "        <Attribute Name=\"" << array.name << "\" AttributeType=\""
+              << (array.components == 1 ? "Scalar" : (array.components == 3 ? "Vector" : "Matrix"))
+              << "\" Center=\"" << (array.kind == Array::cell ? "Cell" : "Node") << "\">\n";
+            writeDataItem( s, "          ", dimensions.str(), array.precision, files[ p ], seeks[ p ][ a ] );
+            s << "        </Attribute>\n";
+            break;
+          }
+        }
+        s << "      </Grid>\n";
+      }
+      s << "    </Grid>\n"
+        << "  </Domain>\n"
+        << "</Xdmf>\n";
+    }
+
+    bool aggregate_;
+  };
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_GRID_IO_FILE_XDMFWRITER_HH
@@ -30,6 +30,8 @@ Dune::OneDGrid::OneDGrid(int numElements, const ctype& leftBoundary, const ctype
 
   // Init grid hierarchy
   entityImps_.resize(1);
+  vertices(0).reserve(numElements+1);
+  elements(0).reserve(numElements);
 
   // Init vertex set
   for (int i=0; i<numElements+1; i++) {
@@ -69,6 +71,8 @@ Dune::OneDGrid::OneDGrid(const std::vector<ctype>& coords)
 
   // Init grid hierarchy
   entityImps_.resize(1);
+  vertices(0).reserve(coords.size());
+  elements(0).reserve(coords.size()-1);
 
   // Init vertex set
   for (size_t i=0; i<coords.size(); i++) {
@@ -98,35 +102,7 @@ Dune::OneDGrid::OneDGrid(const std::vector<ctype>& coords)
 
 Dune::OneDGrid::~OneDGrid()
 {
-  // Delete all vertices
-  for (unsigned int i=0; i<entityImps_.size(); i++) {
-
-    OneDGridList<OneDEntityImp<0> >::iterator v = vertices(i).begin();
-
-    while (v) {
-
-      OneDGridList<OneDEntityImp<0> >::iterator vSucc = v->succ_;
-      vertices(i).erase(v);
-      v = vSucc;
-
-    }
-
-  }
-
-  // Delete all elements
-  for (unsigned int i=0; i<entityImps_.size(); i++) {
-
-    OneDGridList<OneDEntityImp<1> >::iterator e = elements(i).begin();
-
-    while (e) {
-
-      OneDGridList<OneDEntityImp<1> >::iterator eSucc = e->succ_;
-      elements(i).erase(e);
-      e = eSucc;
-
-    }
-
-  }
+  // The vertices and elements are deleted by their lists
 
   // Delete levelIndexSets
   for (unsigned int i=0; i<levelIndexSets_.size(); i++)
@@ -274,9 +250,7 @@ bool Dune::OneDGrid::adapt()
     }
 
   if (toplevelRefinement) {
-    OneDGridList<OneDEntityImp<0> > newVertices;
-    OneDGridList<OneDEntityImp<1> > newElements;
-    entityImps_.push_back(std::tuple<OneDGridList<OneDEntityImp<0> >, OneDGridList<OneDEntityImp<1> > >(newVertices, newElements));
+    entityImps_.emplace_back();
   }
 
   // //////////////////////////////
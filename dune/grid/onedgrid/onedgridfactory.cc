@@ -115,6 +115,8 @@ createGrid()
 
   // Insert the vertices into the grid
   grid_->entityImps_.resize(1);
+  grid_->vertices(0).reserve(vertexPositions_.size());
+  grid_->elements(0).reserve(vertexPositions_.size()-1);
   for (const auto& vtx : vertexPositions_)
   {
     OneDEntityImp<0> newVertex(0, vtx.first, grid_->getNextFreeId());
@@ -5,11 +5,21 @@
 #ifndef DUNE_ONEDGRID_LIST_HH
 #define DUNE_ONEDGRID_LIST_HH
 
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
 #include <dune/common/iteratorfacades.hh>
 
 namespace Dune {
   /** \file
       \brief A simple doubly-linked list needed in OneDGrid
+
+      The list elements are stored in contiguous chunks owned by the list.  Their addresses
+      stay valid until they are erased, which allows to keep pointers to them.
       \todo I'd love to get rid of this and use std::list instead.
       Unfortunately, there are problems.  I need to store pointers/iterators
       within one element which point to another element (e.g. the element father).
@@ -54,21 +64,68 @@ namespace Dune {
   template<class T>
   class OneDGridList
   {
+    // Uninitialized storage for one list element
+    struct alignas(T) Slot
+    {
+      unsigned char data[sizeof(T)];
+    };
+
+    // Sizes of the first and the largest storage chunks
+    static constexpr std::size_t minChunkSize = 16;
+    static constexpr std::size_t maxChunkSize = 4096;
 
   public:
     typedef T* iterator;
     typedef const T* const_iterator;
 
-    OneDGridList() : numelements(0), begin_(0), rbegin_(0) {}
+    OneDGridList() : numelements(0), begin_(0), rbegin_(0), chunkSize_(minChunkSize), used_(0) {}
+
+    // The list owns the storage of its elements.  Moving keeps all element addresses.
+    OneDGridList(const OneDGridList&) = delete;
+    OneDGridList& operator=(const OneDGridList&) = delete;
+
+    OneDGridList(OneDGridList&& other) noexcept
+      : OneDGridList()
+    {
+      swap(other);
+    }
+
+    OneDGridList& operator=(OneDGridList&& other) noexcept
+    {
+      swap(other);
+      return *this;
+    }
+
+    ~OneDGridList()
+    {
+      for (T* i = begin_; i != 0; ) {
+        T* succ = i->succ_;
+        i->~T();
+        i = succ;
+      }
+    }
 
     int size() const {return numelements;}
 
+    /** \brief Make room for n more elements in one contiguous chunk
+
+       Elements created afterwards are stored next to each other in memory, in their order of creation.
+     */
+    void reserve (std::size_t n)
+    {
+      if (!chunks_.empty() && used_ + n <= chunkSize_)
+        return;
+      chunkSize_ = std::max(n, minChunkSize);
+      chunks_.emplace_back(new Slot[chunkSize_]);
+      used_ = 0;
+    }
+
     iterator push_back (const T& value) {
 
       T* i = rbegin();
 
       // New list element by copy construction
-      T* t = new T(value);
+      T* t = allocate(value);
 
       // einfuegen
       if (begin_==0) {
@@ -103,7 +160,7 @@ namespace Dune {
         return push_back(value);
 
       // New list element by copy construction
-      T* t = new T(value);
+      T* t = allocate(value);
 
       // insert
       if (begin_==0)
@@ -152,8 +209,9 @@ namespace Dune {
       // adjust size
       numelements = numelements-1;
 
-      // Actually delete the object
-      delete(i);
+      // Actually delete the object, its storage is reused by the next insertion
+      i->~T();
+      free_.push_back(i);
     }
 
     iterator begin() {
@@ -182,11 +240,49 @@ namespace Dune {
 
   private:
 
+    // Copy-construct a new element in the chunked storage
+    T* allocate (const T& value)
+    {
+      void* slot;
+      if (!free_.empty()) {
+        slot = free_.back();
+        free_.pop_back();
+      } else {
+        if (chunks_.empty() || used_ == chunkSize_) {
+          if (!chunks_.empty())
+            chunkSize_ = std::min(2*chunkSize_, maxChunkSize);
+          chunks_.emplace_back(new Slot[chunkSize_]);
+          used_ = 0;
+        }
+        slot = &chunks_.back()[used_++];
+      }
+      return new (slot) T(value);
+    }
+
+    void swap (OneDGridList& other) noexcept
+    {
+      std::swap(numelements, other.numelements);
+      std::swap(begin_, other.begin_);
+      std::swap(rbegin_, other.rbegin_);
+      chunks_.swap(other.chunks_);
+      std::swap(chunkSize_, other.chunkSize_);
+      std::swap(used_, other.used_);
+      free_.swap(other.free_);
+    }
+
     int numelements;
 
     T* begin_;
     T* rbegin_;
 
+    // Storage chunks, the last one is filled up to used_ of its chunkSize_ slots
+    std::vector<std::unique_ptr<Slot[]> > chunks_;
+    std::size_t chunkSize_;
+    std::size_t used_;
+
+    // Storage of erased elements
+    std::vector<void*> free_;
+
   };   // end class OneDGridList
 
 } // namespace Dune
@@ -6,6 +6,8 @@
 #include <config.h>
 #endif
 
+#include <type_traits>
+
 #include <dune/grid/yaspgrid.hh>
 #include <dune/grid/identitygrid.hh>
 
@@ -31,6 +33,18 @@ void testDim()
 
   gridcheck(identityGrid);
   checkIntersectionIterator(identityGrid);
+
+  // nested IdentityGrids use the geometries of the host grid
+  typedef IdentityGrid<IdentityGrid<GridType> > NestedGridType;
+  static_assert(std::is_same_v<typename NestedGridType::template Codim<0>::Geometry, typename GridType::template Codim<0>::Geometry>);
+  static_assert(std::is_same_v<typename NestedGridType::template Codim<dim>::Geometry, typename GridType::template Codim<dim>::Geometry>);
+  static_assert(std::is_same_v<typename NestedGridType::template Codim<1>::LocalGeometry, typename GridType::template Codim<1>::LocalGeometry>);
+  static_assert(std::is_same_v<typename NestedGridType::LeafIntersection::Geometry, typename GridType::LeafIntersection::Geometry>);
+
+  NestedGridType nestedGrid(identityGrid);
+
+  gridcheck(nestedGrid);
+  checkIntersectionIterator(nestedGrid);
 }
 
 int main (int argc, char *argv[])
@@ -0,0 +1,156 @@
+// SPDX-FileCopyrightText: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#include <config.h>
+
+#include <bitset>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/grid/yaspgrid.hh>
+#include <dune/grid/yaspgrid/checkpoint.hh>
+
+/* Check the single-file checkpoint of YaspGrid:
+ *  - data written on all processes is read back on the same communicator
+ *  - the grid and the data are restored on every process alone, i.e. on a different
+ *    number of processes than used for writing
+ * The data are periodic functions of the entity centers, so that overlap copies
+ * across periodic boundaries can be checked as well.
+ */
+
+template<class Position, int dim>
+double cellValue (const Position& x, const Dune::FieldVector<double,dim>& L)
+{
+  double v = 0.0;
+  for (int i=0; i<dim; i++)
+    v += (i+1) * std::sin(2.0*M_PI*x[i]/L[i]);
+  return v;
+}
+
+template<class Position, int dim>
+Dune::FieldVector<double,2> vertexValue (const Position& x, const Dune::FieldVector<double,dim>& L)
+{
+  Dune::FieldVector<double,2> v(0.0);
+  for (int i=0; i<dim; i++)
+  {
+    v[0] += std::cos(2.0*M_PI*x[i]/L[i]);
+    v[1] += (i+1) * std::sin(2.0*M_PI*x[i]/L[i]);
+  }
+  return v;
+}
+
+template<class Grid>
+int checkData (const Grid& grid, const std::string& filename, const Dune::FieldVector<double,Grid::dimension>& L)
+{
+  const int dim = Grid::dimension;
+
+  Dune::PersistentContainer<Grid,double> cells(grid, 0);
+  Dune::PersistentContainer<Grid,Dune::FieldVector<double,2> > verts(grid, dim);
+
+  Dune::YaspCheckpoint<Grid> checkpoint(filename);
+  checkpoint.add("cells", cells);
+  checkpoint.add("vertices", verts);
+  checkpoint.read(grid);
+
+  int errors = 0;
+  for (const auto& e : elements(grid.leafGridView()))
+    if (std::abs(cells[e] - cellValue(e.geometry().center(), L)) > 1e-10)
+      ++errors;
+  for (const auto& v : vertices(grid.leafGridView()))
+  {
+    auto diff = verts[v] - vertexValue(v.geometry().center(), L);
+    if (diff.infinity_norm() > 1e-10)
+      ++errors;
+  }
+
+  if (errors > 0)
+    std::cerr << "Wrong data read from checkpoint '" << filename << "' on "
+              << grid.comm().size() << " processes" << std::endl;
+  return errors > 0;
+}
+
+template<class Grid>
+int checkCheckpoint (Grid& grid, const std::string& filename, const Dune::FieldVector<double,Grid::dimension>& L)
+{
+  const int dim = Grid::dimension;
+  grid.globalRefine(1);
+
+  Dune::PersistentContainer<Grid,double> cells(grid, 0);
+  Dune::PersistentContainer<Grid,Dune::FieldVector<double,2> > verts(grid, dim);
+  for (const auto& e : elements(grid.leafGridView()))
+    cells[e] = cellValue(e.geometry().center(), L);
+  for (const auto& v : vertices(grid.leafGridView()))
+    verts[v] = vertexValue(v.geometry().center(), L);
+
+  Dune::YaspCheckpoint<Grid> checkpoint(filename);
+  checkpoint.add("cells", cells);
+  checkpoint.add("vertices", verts);
+  checkpoint.write(grid);
+
+  int result = checkData(grid, filename, L);
+
+  // restore on all processes
+  Dune::YaspCheckpoint<Grid> restart(filename);
+  std::unique_ptr<Grid> restored(restart.restoreGrid(grid.comm()));
+  if (restored->maxLevel() != grid.maxLevel() || restored->globalSize() != grid.globalSize())
+  {
+    std::cerr << "Restored grid differs from the written one" << std::endl;
+    result = 1;
+  }
+  result += checkData(*restored, filename, L);
+
+  // restore on each process alone
+#if HAVE_MPI
+  std::unique_ptr<Grid> single(restart.restoreGrid(typename Grid::Communication(MPI_COMM_SELF)));
+  result += checkData(*single, filename, L);
+#endif
+
+  return result;
+}
+
+int main (int argc, char** argv)
+{
+  try
+  {
+    const auto& mpiHelper = Dune::MPIHelper::instance(argc, argv);
+    const std::string prefix = "checkpoint-np" + std::to_string(mpiHelper.size());
+
+    int result = 0;
+
+    {
+      Dune::FieldVector<double,2> L = {1.0, 2.0};
+      Dune::YaspGrid<2> grid(L, {8, 6}, std::bitset<2>(1ULL), 1);
+      result += checkCheckpoint(grid, prefix + "-equidistant.ckpt", L);
+    }
+
+    {
+      typedef Dune::YaspGrid<3, Dune::EquidistantOffsetCoordinates<double,3> > Grid;
+      Dune::FieldVector<double,3> lowerleft = {-1.0, 0.5, 0.0};
+      Dune::FieldVector<double,3> upperright = {1.0, 1.5, 1.0};
+      Grid grid(lowerleft, upperright, {4, 4, 6}, std::bitset<3>(6ULL), 1);
+      result += checkCheckpoint(grid, prefix + "-equidistantoffset.ckpt", upperright - lowerleft);
+    }
+
+    {
+      typedef Dune::YaspGrid<2, Dune::TensorProductCoordinates<double,2> > Grid;
+      std::array<std::vector<double>,2> coords;
+      coords[0] = {0.0, 0.1, 0.3, 0.6, 1.0, 1.5, 2.0};
+      coords[1] = {0.0, 0.5, 0.75, 1.0, 1.25, 1.5, 2.0};
+      Grid grid(coords, std::bitset<2>(2ULL), 1);
+      result += checkCheckpoint(grid, prefix + "-tensor.ckpt", Dune::FieldVector<double,2>{2.0, 2.0});
+    }
+
+    return result;
+  }
+  catch (Dune::Exception& e)
+  {
+    std::cerr << e << std::endl;
+    return 1;
+  }
+}
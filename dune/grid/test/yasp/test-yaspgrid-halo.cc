@@ -0,0 +1,204 @@
+// SPDX-FileCopyrightText: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#include <config.h>
+
+#include <array>
+#include <bitset>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/grid/common/datahandleif.hh>
+#include <dune/grid/yaspgrid.hh>
+
+/* Check the communication of YaspGrid restricted to halo layers:
+ *  - the full halo range [0,overlap) matches the standard communication
+ *  - the ranges [0,k) and [k,overlap) partition the full halo
+ *  - the data received for an entity stems from the same global entity
+ * All checks are repeated with the shared memory exchange between processes on a node
+ * and with persistent communication requests.
+ */
+
+// Data handle that sends a global, periodicity-aware key for each entity and counts receives
+template<class GridView>
+class HaloCountHandle
+  : public Dune::CommDataHandleIF<HaloCountHandle<GridView>, long>
+{
+  static const int dim = GridView::dimension;
+
+public:
+  HaloCountHandle (const GridView& gv, const std::array<int,dim>& cells, const Dune::FieldVector<double,dim>& h)
+    : gv_(gv), cells_(cells), h_(h), errors_(0)
+  {
+    counts_[0].assign(gv.size(0), 0);
+    counts_[1].assign(gv.size(dim), 0);
+  }
+
+  bool contains (int, int codim) const
+  {
+    return codim == 0 || codim == dim;
+  }
+
+  bool fixedSize (int, int) const
+  {
+    return true;
+  }
+
+  template<class Entity>
+  std::size_t size (const Entity&) const
+  {
+    return 1;
+  }
+
+  template<class Buffer, class Entity>
+  void gather (Buffer& buf, const Entity& e) const
+  {
+    buf.write(key(e));
+  }
+
+  template<class Buffer, class Entity>
+  void scatter (Buffer& buf, const Entity& e, std::size_t n)
+  {
+    if (n != 1)
+      ++errors_;
+    long k;
+    buf.read(k);
+    if (k != key(e))
+      ++errors_;
+    ++counts_[Entity::codimension == 0 ? 0 : 1][gv_.indexSet().index(e)];
+  }
+
+  const std::vector<int>& counts (int i) const
+  {
+    return counts_[i];
+  }
+
+  int errors () const
+  {
+    return errors_;
+  }
+
+private:
+  // cell centers and vertices are on a grid with spacing h/2, wrap around periodically
+  template<class Entity>
+  long key (const Entity& e) const
+  {
+    auto x = e.geometry().center();
+    long k = 0;
+    for (int i=dim-1; i>=0; i--)
+    {
+      long n = 2*cells_[i];
+      long c = std::lround(2.0*x[i]/h_[i]);
+      k = k*n + ((c%n)+n)%n;
+    }
+    return k;
+  }
+
+  GridView gv_;
+  std::array<int,dim> cells_;
+  Dune::FieldVector<double,dim> h_;
+  std::array<std::vector<int>,2> counts_;
+  int errors_;
+};
+
+template<int dim>
+int checkHalo (std::bitset<dim> periodic, Dune::InterfaceType iftype, int sharedMemory, bool persistent)
+{
+  const int overlap = 2;
+  Dune::FieldVector<double,dim> L(1.0);
+  std::array<int,dim> cells;
+  cells.fill(8);
+  cells[0] = 16;
+  Dune::YaspGrid<dim> grid(L, cells, periodic, overlap);
+  // sharedMemory: 0 off, 1 with the default window size, 2 starting with windows too small for any message
+  if (sharedMemory > 0)
+    grid.sharedMemoryCommunication(true, sharedMemory == 1 ? std::size_t(1) << 20 : 0);
+  grid.persistentCommunication(persistent);
+
+  Dune::FieldVector<double,dim> h;
+  for (int i=0; i<dim; i++)
+    h[i] = L[i]/cells[i];
+
+  auto gv = grid.levelGridView(0);
+  using Handle = HaloCountHandle<decltype(gv)>;
+
+  Handle standard(gv, cells, h);
+  grid.communicate(standard, iftype, Dune::ForwardCommunication, 0);
+
+  // grow the windows to the messages sent so far
+  if (sharedMemory == 2)
+    grid.sharedMemoryCommunication(true);
+
+  Handle full(gv, cells, h);
+  grid.communicate(full, iftype, Dune::ForwardCommunication, 0, overlap);
+
+  Handle inner(gv, cells, h);
+  grid.communicate(inner, iftype, Dune::ForwardCommunication, 0, 1);
+
+  Handle outer(gv, cells, h);
+  grid.communicate(outer, iftype, Dune::ForwardCommunication, 0, overlap, 1);
+
+  // repeat with the cached lists (and buffers in persistent mode)
+  Handle outerAgain(gv, cells, h);
+  grid.communicate(outerAgain, iftype, Dune::ForwardCommunication, 0, overlap, 1);
+
+  int result = 0;
+  for (const Handle* handle : {&standard, &full, &inner, &outer, &outerAgain})
+    if (handle->errors() > 0)
+    {
+      std::cerr << "Received data from the wrong entity" << std::endl;
+      result = 1;
+    }
+
+  for (int i=0; i<2; i++)
+  {
+    if (full.counts(i) != standard.counts(i))
+    {
+      std::cerr << "Full halo exchange differs from standard communication" << std::endl;
+      result = 1;
+    }
+    if (outerAgain.counts(i) != outer.counts(i))
+    {
+      std::cerr << "Cached halo lists differ from freshly built ones" << std::endl;
+      result = 1;
+    }
+    for (std::size_t j=0; j<full.counts(i).size(); j++)
+      if (inner.counts(i)[j] + outer.counts(i)[j] != full.counts(i)[j])
+      {
+        std::cerr << "Halo layers do not partition the full halo" << std::endl;
+        result = 1;
+        break;
+      }
+  }
+
+  return result;
+}
+
+int main (int argc, char** argv)
+{
+  try
+  {
+    Dune::MPIHelper::instance(argc, argv);
+
+    int result = 0;
+    for (int sharedMemory : {0, 1, 2})
+      for (bool persistent : {false, true})
+        for (auto iftype : {Dune::InteriorBorder_All_Interface, Dune::Overlap_All_Interface, Dune::All_All_Interface})
+        {
+          result += checkHalo<2>(std::bitset<2>(0ULL), iftype, sharedMemory, persistent);
+          result += checkHalo<2>(std::bitset<2>(3ULL), iftype, sharedMemory, persistent);
+          result += checkHalo<3>(std::bitset<3>(1ULL), iftype, sharedMemory, persistent);
+        }
+
+    return result;
+  }
+  catch (Dune::Exception& e)
+  {
+    std::cerr << e << std::endl;
+    return 1;
+  }
+}
@@ -6,12 +6,14 @@
 #include <config.h>
 
 #include <array>
+#include <bitset>
 #include <cassert>
 #include <iostream>
 
 #include <dune/common/filledarray.hh>
 #include <dune/common/parallel/mpihelper.hh>
 #include <dune/grid/common/exceptions.hh>
+#include <dune/grid/yaspgrid.hh>
 #include <dune/grid/yaspgrid/partitioning.hh>
 
 template <int d>
@@ -112,6 +114,42 @@ void test (const Partitioner& partitioner)
   }
 }
 
+template <std::size_t d>
+void test_nodes (const Dune::Yasp::Partitioning<d>& partitioner)
+{
+  std::array<int,d> size;
+  size.fill(24);
+
+  for (int nodes = 1; nodes <= 8; ++nodes) {
+    for (int ranksPerNode = 1; ranksPerNode <= 8; ++ranksPerNode) {
+      std::array<int,d> nodeDims, localDims;
+      partitioner.partitionNodes(size,nodes,ranksPerNode,nodeDims,localDims,0);
+
+      // Check that the node blocks and the blocks within a node cover all processes
+      int n = 1, r = 1;
+      for (std::size_t i = 0; i < d; ++i) {
+        assert(nodeDims[i] > 0 && localDims[i] > 0);
+        n *= nodeDims[i];
+        r *= localDims[i];
+      }
+      assert(n == nodes);
+      assert(r == ranksPerNode);
+    }
+  }
+}
+
+// The grid communicates on the communicator of the torus, which node-aware placement may reorder
+template <int d>
+void test_grid_comm (const Dune::Yasp::Partitioning<d>& partitioner)
+{
+  Dune::FieldVector<double,d> L(1.0);
+  auto s = Dune::filledArray<d>(8);
+  Dune::YaspGrid<d> grid(L, s, std::bitset<d>(0ULL), 1, Dune::MPIHelper::getCommunication(), &partitioner);
+
+  assert(grid.comm().rank() == grid.torus().rank());
+  assert(grid.comm().size() == grid.torus().procs());
+  assert(grid.comm().sum(1) == grid.torus().procs());
+}
 
 int main (int argc , char **argv)
 {
@@ -122,6 +160,15 @@ int main (int argc , char **argv)
   Dune::Yasp::DefaultPartitioning<2> p2; test<2>(p2);
   Dune::Yasp::DefaultPartitioning<3> p3; test<3>(p3);
 
+  // The node-aware partitioner behaves like the default one if no node information is used
+  Dune::Yasp::NodeAwarePartitioning<1> n1; test<1>(n1); test_nodes<1>(n1);
+  Dune::Yasp::NodeAwarePartitioning<2> n2; test<2>(n2); test_nodes<2>(n2);
+  Dune::Yasp::NodeAwarePartitioning<3> n3(true); test<3>(n3); test_nodes<3>(n3);
+  assert(n1.nodeAware() && !n1.reorder() && n3.reorder());
+  assert(!p1.nodeAware());
+  test_grid_comm<2>(n2);
+  test_grid_comm<3>(n3);
+
   // Test construction of partitioners
   {
     Dune::Yasp::PowerDPartitioning<1> ylbp1;
@@ -14,21 +14,27 @@
  *  - Using matrix and vector routines from the PETSc or trilinos parallel linear algebra
  *    packages for distributed memory parallel computers.
  *
- *  Method: (1) The UniqueEntityPartition class assigns an owner process to each entity
+ *  Method: (1) Assign an owner process to each entity
  *
- *          (2) Compute the number of entities that are owned by each process
+ *          (2) Number the entities owned by each process consecutively, starting at the number of
+ *              entities owned by all processes of lower rank (an exclusive scan)
  *
  *          (3) we communicate the index of entities that are owned by the process to processes
  *              that also contain these entities but do not own them, so that on a non-owner process
  *              we have information on the index of the entity that it got from the owner-process;
  *
+ *  The global indices are stored in a vector indexed by a local mapper, so looking up the index
+ *  of an entity takes constant time.
+ *
+ *  After grid adaptation or load balancing, an updatable index set can be renumbered by update(),
+ *  which keeps the owners and the order of the remaining entities, and returns the map from old to
+ *  new global indices. Like the construction, this only communicates over the process interface.
+ *
  *  \author    Benedikt Oswald, Patrick Leidenberger, Oliver Sander
  *
  *  \attention globally unique indices are ONLY provided for entities of the
  *             InteriorBorder_Partition type, NOT for the Ghost_Partition type !!!
  *
- *  \bug This code will most likely not work on grids with more than one element type.
- *       Please ask on the mailing list if you need this feature.
  *  \note The interface in this file is experimental, and may change without prior notice.
  */
 
@@ -37,20 +43,26 @@
 
 /** \brief Include standard header files. */
 #include <vector>
-#include <iostream>
-#include <fstream>
-#include <memory>
-#include <map>
-#include <utility>
 #include <algorithm>
+#include <numeric>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <dune/common/exceptions.hh>
 
 /** include base class functionality for the communication interface */
+#include <dune/geometry/type.hh>
 #include <dune/grid/common/gridenums.hh>
 #include <dune/grid/common/datahandleif.hh>
+#include <dune/grid/common/mcmgmapper.hh>
+#include <dune/grid/common/rangegenerators.hh>
+#include <dune/grid/utility/persistentcontainer.hh>
 
 /** include parallel capability */
 #if HAVE_MPI
   #include <dune/common/parallel/mpihelper.hh>
+  #include <dune/common/parallel/mpitraits.hh>
 #endif
 
 namespace Dune
@@ -97,137 +109,15 @@ namespace Dune
     /** define data types */
     typedef typename GridView::Grid Grid;
 
-    typedef typename GridView::Grid::GlobalIdSet GlobalIdSet;
-    typedef typename GridView::Grid::GlobalIdSet::IdType IdType;
-    typedef typename GridView::Traits::template Codim<0>::Iterator Iterator;
-
     typedef typename Grid::Communication Communication;
 
-    typedef std::map<IdType,Index> MapId2Index;
-    typedef std::map<Index,Index>    IndexMap;
-
-    /*********************************************************************************************/
-    /* calculate unique partitioning for all entities of a given codim in a given GridView,      */
-    /* assuming they all have the same geometry, i.e. codim, type                                */
-    /*********************************************************************************************/
-    class UniqueEntityPartition
-    {
-    private:
-      /* A DataHandle class to calculate the minimum of a std::vector which is accompanied by an index set */
-      template<class IS, class V> // mapper type and vector type
-      class MinimumExchange
-      : public Dune::CommDataHandleIF<MinimumExchange<IS,V>,typename V::value_type>
-      {
-      public:
-        //! export type of data for message buffer
-        typedef typename V::value_type DataType;
-
-        //! returns true if data for this codim should be communicated
-        bool contains (int /*dim*/, unsigned int codim) const
-        {
-          return codim==indexSetCodim_;
-        }
-
-        //! returns true if size per entity of given dim and codim is a constant
-        bool fixedSize (int /*dim*/, int /*codim*/) const
-        {
-          return true ;
-        }
-
-        /*! how many objects of type DataType have to be sent for a given entity
-         *
-         *  Note: Only the sender side needs to know this size. */
-        template<class EntityType>
-        std::size_t size (EntityType&) const
-        {
-          return 1 ;
-        }
-
-        /*! pack data from user to message buffer */
-        template<class MessageBuffer, class EntityType>
-        void gather (MessageBuffer& buff, const EntityType& e) const
-        {
-          buff.write(v_[indexset_.index(e)]);
-        }
-
-        /** \brief Unpack data from message buffer to user
-         *
-         * \param n The number of objects sent by the sender
-         */
-        template<class MessageBuffer, class EntityType>
-        void scatter (MessageBuffer& buff, const EntityType& e, std::size_t)
-        {
-          DataType x;
-          buff.read(x);
-          if (x>=0) // other is -1 means, he does not want it
-            v_[indexset_.index(e)] = std::min(x,v_[indexset_.index(e)]);
-        }
-
-        //! constructor
-        MinimumExchange (const IS& indexset, V& v, unsigned int indexSetCodim)
-        : indexset_(indexset),
-          v_(v),
-          indexSetCodim_(indexSetCodim)
-        {}
-
-      private:
-        const IS& indexset_;
-        V& v_;
-        unsigned int indexSetCodim_;
-      };
-
-    public:
-      /*! \brief Constructor needs to know the grid function space
-       */
-      UniqueEntityPartition (const GridView& gridview, unsigned int codim)
-      : assignment_(gridview.size(codim))
-      {
-        /** extract types from the GridView data type */
-        typedef typename GridView::IndexSet IndexSet;
-
-        // assign own rank to entities that I might have
-        for (auto it = gridview.template begin<0>(); it!=gridview.template end<0>(); ++it)
-          for (unsigned int i=0; i<it->subEntities(codim); i++)
-          {
-            // Evil hack: I need to call subEntity, which needs the entity codimension as a static parameter.
-            // However, we only have it as a run-time parameter.
-            PartitionType subPartitionType = SubPartitionTypeProvider<typename GridView::template Codim<0>::Entity, GridView::dimension>::get(*it,codim,i);
-
-            assignment_[gridview.indexSet().subIndex(*it,i,codim)]
-              = ( subPartitionType==Dune::InteriorEntity or subPartitionType==Dune::BorderEntity )
-              ? gridview.comm().rank()  // set to own rank
-              : - 1;   // it is a ghost entity, I will not possibly own it.
-          }
-
-        /** exchange entity index through communication */
-        MinimumExchange<IndexSet,std::vector<Index> > dh(gridview.indexSet(),assignment_,codim);
-
-        gridview.communicate(dh,Dune::All_All_Interface,Dune::ForwardCommunication);
-      }
-
-      /** \brief Which rank is the i-th entity assigned to? */
-      int owner(std::size_t i)
-      {
-        return assignment_[i];
-      }
-
-      /** \brief Report the number of entities assigned to the rank 'rank' */
-      std::size_t numOwners(int rank) const
-      {
-        return std::count(assignment_.begin(), assignment_.end(), rank);
-      }
-
-    private:
-      std::vector<int> assignment_;
-    };
+    typedef MultipleCodimMultipleGeomTypeMapper<GridView> Mapper;
 
-  private:
-    /* A DataHandle class to communicate the global index from the
-     * owning to the non-owning entity; the class is based on the MinimumExchange
-     * class in the parallelsolver.hh header file.
+    /* A DataHandle class to calculate the minimum of the non-negative values in a std::vector
+     * indexed by a mapper; negative values mark entries that are not set, yet.
      */
-    class IndexExchange
-    : public Dune::CommDataHandleIF<IndexExchange,Index>
+    class MinimumExchange
+    : public Dune::CommDataHandleIF<MinimumExchange,Index>
     {
     public:
       //! returns true if data for this codim should be communicated
@@ -256,12 +146,7 @@ namespace Dune
       template<class MessageBuffer, class EntityType>
       void gather (MessageBuffer& buff, const EntityType& e) const
       {
-        IdType id=globalidset_.id(e);
-
-        if (indexSetCodim_==0)
-          buff.write(mapid2entity_[id]);
-        else
-          buff.write((*mapid2entity_.find(id)).second);
+        buff.write(v_[mapper_.index(e)]);
       }
 
       /** \brief Unpack data from message buffer to user
@@ -269,200 +154,122 @@ namespace Dune
        * \param n The number of objects sent by the sender
        */
       template<class MessageBuffer, class EntityType>
-      void scatter (MessageBuffer& buff, const EntityType& entity, std::size_t)
+      void scatter (MessageBuffer& buff, const EntityType& e, std::size_t)
       {
         Index x;
         buff.read(x);
 
-        /** only if the incoming index is a valid one,
-         *  i.e. if it is greater than zero, will it be
-         *  inserted as the global index; it is made
-         *  sure in the upper class, i.e. GlobalIndexSet,
-         *  that non-owning processes use -1 to mark an entity
-         *  that they do not own.
-         */
-        if(x >= 0) {
-          const IdType id = globalidset_.id(entity);
-
-          if (indexSetCodim_==0)
-            mapid2entity_[id] = x;
-          else
-          {
-            mapid2entity_.erase(id);
-            mapid2entity_.insert(std::make_pair(id,x));
-
-            const Index lindex = indexSet_.index(entity);
-            localGlobalMap_[lindex] = x;
-          }
-        }
+        Index& v = v_[mapper_.index(e)];
+        if ((x >= 0) && ((v < 0) || (x < v)))
+          v = x;
       }
 
       //! constructor
-      IndexExchange (const GlobalIdSet& globalidset, MapId2Index& mapid2entity,
-                     const typename GridView::IndexSet& localIndexSet, IndexMap& localGlobal,
-                     unsigned int indexSetCodim)
-      : globalidset_(globalidset),
-      mapid2entity_(mapid2entity),
-      indexSet_(localIndexSet),
-      localGlobalMap_(localGlobal),
-      indexSetCodim_(indexSetCodim)
+      MinimumExchange (const Mapper& mapper, std::vector<Index>& v, unsigned int indexSetCodim)
+      : mapper_(mapper),
+        v_(v),
+        indexSetCodim_(indexSetCodim)
       {}
 
     private:
-      const GlobalIdSet& globalidset_;
-      MapId2Index& mapid2entity_;
-
-      const typename GridView::IndexSet& indexSet_;
-      IndexMap& localGlobalMap_;
+      const Mapper& mapper_;
+      std::vector<Index>& v_;
       unsigned int indexSetCodim_;
     };
 
+    /** \brief Return the sum of n over all processes of lower rank */
+    static Index exclusiveSum (const Communication& comm, Index n)
+    {
+#if HAVE_MPI
+      if constexpr (std::is_same_v<Communication, Dune::Communication<MPI_Comm> >)
+      {
+        Index offset = 0;
+        MPI_Exscan(&n, &offset, 1, MPITraits<Index>::getType(), MPI_SUM, comm);
+
+        // the result of MPI_Exscan is undefined on rank 0
+        return (comm.rank() > 0) ? offset : 0;
+      }
+      else
+#endif
+      {
+        std::vector<Index> counts(comm.size());
+        comm.template allgather<Index>(&n, 1, counts.data());
+        return std::accumulate(counts.begin(), counts.begin() + comm.rank(), Index(0));
+      }
+    }
+
+    /** \brief Previous global index of an entity, kept for update() */
+    struct PreviousIndex
+    {
+      Index index = -1;
+      bool owner = false;
+    };
+
+    typedef PersistentContainer<Grid,PreviousIndex> PreviousIndices;
+
   public:
     /** \brief Constructor for a given GridView
      *
      * This constructor calculates the complete set of global unique indices so that we can then
      *  later query the global index, by directly passing the entity in question.
+     *
+     * \param updatable Keep the global indices in a PersistentContainer, so they can be reused by
+     *                  update() after the grid has been adapted or load balanced.
      */
-    GlobalIndexSet(const GridView& gridview, int codim)
+    GlobalIndexSet(const GridView& gridview, int codim, bool updatable = false)
     : gridview_(gridview),
-      codim_(codim)
+      codim_(codim),
+      mapper_(gridview, [codim] (GeometryType gt, int dim) { return (dim - static_cast<int>(gt.dim()) == codim) ? 1 : 0; })
     {
-      int rank = gridview.comm().rank();
-      int size = gridview.comm().size();
-
-      const typename GridView::IndexSet& indexSet = gridview.indexSet();
-
-      std::unique_ptr<UniqueEntityPartition> uniqueEntityPartition;
-      if (codim_!=0)
-        uniqueEntityPartition = std::make_unique<UniqueEntityPartition>(gridview,codim_);
-
-      int nLocalEntity = (codim_==0)
-                    ? std::distance(gridview.template begin<0, Dune::Interior_Partition>(), gridview.template end<0, Dune::Interior_Partition>())
-                    : uniqueEntityPartition->numOwners(rank);
-
-      // Compute the global, non-redundant number of entities, i.e. the number of entities in the set
-      // without double, aka. redundant entities, on the interprocessor boundary via global reduce. */
-      nGlobalEntity_ = gridview.comm().template sum<int>(nLocalEntity);
-
-      /* communicate the number of locally owned entities to all other processes so that the respective offset
-       * can be calculated on the respective processor; we use the Dune mpi communication facility
-       * for this; first, we gather the number of locally owned entities on the root process and, second, we
-       * broadcast the array to all processes where the respective offset can be calculated. */
-
-      std::vector<int> offset(size);
-      std::fill(offset.begin(), offset.end(), 0);
-
-      /** Share number of locally owned entities */
-      gridview_.comm().template allgather<int>(&nLocalEntity, 1, offset.data());
-
-      int myoffset = 0;
-      for (int i=1; i<rank+1; i++)
-        myoffset += offset[i-1];
-
-      /*  compute globally unique index over all processes; the idea of the algorithm is as follows: if
-       *  an entity is owned by the process, it is assigned an index that is the addition of the offset
-       *  specific for this process and a consecutively incremented counter; if the entity is not owned
-       *  by the process, it is assigned -1, which signals that this specific entity will get its global
-       *  unique index through communication afterwards;
-       *
-       *  thus, the calculation of the globally unique index is divided into 2 stages:
-       *
-       *  (1) we calculate the global index independently;
-       *
-       *  (2) we achieve parallel adjustment by communicating the index
-       *      from the owning entity to the non-owning entity.
-       *
-       */
-
-      // 1st stage of global index calculation: calculate global index for owned entities
-      // initialize map that stores an entity's global index via it's globally unique id as key
-      globalIndex_.clear();
-
-      const GlobalIdSet& globalIdSet = gridview_.grid().globalIdSet();      /** retrieve globally unique Id set */
-
-      Index globalcontrib = 0;      /** initialize contribution for the global index */
-
-      if (codim_==0)  // This case is simpler
-      {
-        for (Iterator iter = gridview_.template begin<0>(); iter!=gridview_.template end<0>(); ++iter)
-        {
-          const IdType id = globalIdSet.id(*iter);      /** retrieve the entity's id */
-
-          /** if the entity is owned by the process, go ahead with computing the global index */
-          if (iter->partitionType() == Dune::InteriorEntity)
-          {
-            const Index gindex = myoffset + globalcontrib;    /** compute global index */
-
-            globalIndex_[id] = gindex;                      /** insert pair (key, datum) into the map */
-            globalcontrib++;                                /** increment contribution to global index */
-          }
-
-          /** if entity is not owned, insert -1 to signal not yet calculated global index */
-          else
-          {
-            globalIndex_[id] = -1;     /** insert pair (key, datum) into the map */
-          }
-        }
-      }
-      else  // if (codim==0) else
-      {
-      std::vector<bool> firstTime(gridview_.size(codim_));
-      std::fill(firstTime.begin(), firstTime.end(), true);
-
-      for(Iterator iter = gridview_.template begin<0>();iter!=gridview_.template end<0>(); ++iter)
-      {
-        for (std::size_t i=0; i<iter->subEntities(codim_); i++)
-        {
-          IdType id=globalIdSet.subId(*iter,i,codim_);
-
-          Index idx = gridview_.indexSet().subIndex(*iter,i,codim_);
+      if (updatable)
+        previousIndices_.emplace(gridview_.grid(), codim_, PreviousIndex());
 
-          if (!firstTime[idx] )
-            continue;
-
-          firstTime[idx] = false;
-
-          if (uniqueEntityPartition->owner(idx) == rank)  /** if the entity is owned by the process, go ahead with computing the global index */
-          {
-            const Index gindex = myoffset + globalcontrib;    /** compute global index */
-            globalIndex_.insert(std::make_pair(id,gindex)); /** insert pair (key, value) into the map */
-
-            const Index lindex = idx;
-            localGlobalMap_[lindex] = gindex;
-
-            globalcontrib++;                                /** increment contribution to global index */
-          }
-          else /** if entity is not owned, insert -1 to signal not yet calculated global index */
-          {
-            globalIndex_.insert(std::make_pair(id,-1));
-          }
-        }
-
-      }
-      }
-
-      // 2nd stage of global index calculation: communicate global index for non-owned entities
+      computeIndices();
+    }
 
-      // Create the data handle and communicate.
-      IndexExchange dataHandle(globalIdSet,globalIndex_,indexSet,localGlobalMap_,codim_);
-      gridview_.communicate(dataHandle, Dune::All_All_Interface, Dune::ForwardCommunication);
+    /** \brief Update the global indices after the grid has been adapted or load balanced
+     *
+     * The entities that are still owned by the same process as before keep their owner, all other
+     * entities are assigned to an owner as in the constructor. Each process numbers the entities it
+     * has kept first, in the order of their old indices, followed by the entities it has gained, and
+     * all offsets are given by an exclusive scan. Hence the remaining entities keep their order, and
+     * like the constructor only the process interface is communicated; no process needs to know the
+     * entities that have been removed elsewhere.
+     *
+     * \returns pairs of old and new global index for all entities of the grid view on this process
+     *          that have had a global index before the update, sorted by the old index
+     *
+     * \note The index set has to be constructed with \a updatable set.
+     */
+    std::vector<std::pair<Index,Index> > update()
+    {
+      if (!previousIndices_)
+        DUNE_THROW(InvalidStateException, "GlobalIndexSet::update() requires an updatable index set");
+
+      // fetch the previous indices of the current entities
+      mapper_.update(gridview_);
+      previousIndices_->resize(PreviousIndex());
+
+      std::vector<PreviousIndex> previous(mapper_.size());
+      for (const auto& element : elements(gridview_))
+        for (unsigned int i=0; i<element.subEntities(codim_); i++)
+          previous[mapper_.subIndex(element,i,codim_)] = (*previousIndices_)(element,i);
+
+      computeIndices(previous);
+
+      std::vector<std::pair<Index,Index> > oldToNew;
+      for (std::size_t i=0; i<previous.size(); i++)
+        if ((previous[i].index >= 0) && (globalIndex_[i] >= 0))
+          oldToNew.emplace_back(previous[i].index, globalIndex_[i]);
+      std::sort(oldToNew.begin(), oldToNew.end());
+      return oldToNew;
     }
 
     /** \brief Return the global index of a given entity */
     template <class Entity>
     Index index(const Entity& entity) const
     {
-      if (codim_==0)
-      {
-        /** global unique index is only applicable for inter or border type entities */
-        const GlobalIdSet& globalIdSet = gridview_.grid().globalIdSet(); /** retrieve globally unique Id set */
-        const IdType id = globalIdSet.id(entity);                        /** obtain the entity's id */
-        const Index gindex = globalIndex_.find(id)->second;                /** retrieve the global index in the map with the id as key */
-
-        return gindex;
-      }
-      else
-        return localGlobalMap_.find(gridview_.indexSet().index(entity))->second;
+      return globalIndex_[mapper_.index(entity)];
     }
 
     /** \brief Return the global index of a subentity of a given entity
@@ -473,17 +280,7 @@ namespace Dune
     template <class Entity>
     Index subIndex(const Entity& entity, unsigned int i, unsigned int codim) const
     {
-      if (codim_==0)
-      {
-        /** global unique index is only applicable for inter or border type entities */
-        const GlobalIdSet& globalIdSet = gridview_.grid().globalIdSet(); /** retrieve globally unique Id set */
-        const IdType id = globalIdSet.subId(entity,i,codim);                        /** obtain the entity's id */
-        const Index gindex = globalIndex_.find(id)->second;                /** retrieve the global index in the map with the id as key */
-
-        return gindex;
-      }
-      else
-        return localGlobalMap_.find(gridview_.indexSet().subIndex(entity,i,codim))->second;
+      return globalIndex_[mapper_.subIndex(entity,i,codim)];
     }
 
     /** \brief Return the total number of entities over all processes that we have indices for
@@ -496,6 +293,98 @@ namespace Dune
       return (codim_==codim) ? nGlobalEntity_ : 0;
     }
 
+  private:
+    /** \brief Return true if the i-th subentity of given codimension of an element may be owned by this process */
+    template<class Element>
+    bool interiorOrBorder(const Element& element, unsigned int i) const
+    {
+      if (codim_==0)
+        return (element.partitionType() == Dune::InteriorEntity);
+
+      // Evil hack: I need to call subEntity, which needs the entity codimension as a static parameter.
+      // However, we only have it as a run-time parameter.
+      PartitionType subPartitionType = SubPartitionTypeProvider<Element, GridView::dimension>::get(element,codim_,i);
+      return ( subPartitionType==Dune::InteriorEntity or subPartitionType==Dune::BorderEntity );
+    }
+
+    /** \brief Compute the global indices
+     *
+     * \param previous The previous indices of the entities, empty when numbering from scratch
+     */
+    void computeIndices(const std::vector<PreviousIndex>& previous = {})
+    {
+      const int rank = gridview_.comm().rank();
+      const int size = gridview_.comm().size();
+
+      /* (1) assign an owner to each entity: elements are owned by the process they are interior to.
+       *     All other entities are owned by the process that has owned them before, if it still has
+       *     them as interior or border entity, and otherwise by the process of lowest rank having
+       *     them as interior or border entity. The former bid their rank, the latter their rank plus
+       *     the number of processes; ghost entities are marked by -1. */
+      std::vector<Index> owner(mapper_.size(), -1);
+      for (const auto& element : elements(gridview_))
+        for (unsigned int i=0; i<element.subEntities(codim_); i++)
+        {
+          const std::size_t idx = mapper_.subIndex(element,i,codim_);
+          if (interiorOrBorder(element,i))
+            owner[idx] = (!previous.empty() && previous[idx].owner) ? rank : rank + size;
+        }
+
+      // only interior and border copies compete for the ownership
+      if (codim_!=0)
+      {
+        MinimumExchange ownerExchange(mapper_,owner,codim_);
+        gridview_.communicate(ownerExchange, Dune::InteriorBorder_InteriorBorder_Interface, Dune::ForwardCommunication);
+      }
+
+      // (2) the entities kept from the previous numbering come first, in the order of their old indices
+      std::vector<std::size_t> order;
+      for (std::size_t i=0; i<owner.size(); i++)
+        if (owner[i] == rank)
+          order.push_back(i);
+      std::sort(order.begin(), order.end(), [&] (std::size_t i, std::size_t j) {
+          return previous[i].index < previous[j].index;
+        });
+      for (std::size_t i=0; i<owner.size(); i++)
+        if (owner[i] == rank + size)
+          order.push_back(i);
+
+      // (3) number the owned entities consecutively, starting at the sum of the owned entities of all lower ranks
+      const Index nLocalEntity = order.size();
+      nGlobalEntity_ = gridview_.comm().sum(nLocalEntity);
+
+      Index globalIndex = exclusiveSum(gridview_.comm(), nLocalEntity);
+      globalIndex_.assign(owner.size(), -1);
+      std::vector<char> owned(owner.size(), false);
+      for (std::size_t i : order)
+      {
+        globalIndex_[i] = globalIndex++;
+        owned[i] = true;
+      }
+
+      // (4) communicate the global index from the owner to all other copies
+      MinimumExchange indexExchange(mapper_,globalIndex_,codim_);
+      gridview_.communicate(indexExchange, Dune::All_All_Interface, Dune::ForwardCommunication);
+
+      storeIndices(owned);
+    }
+
+    /** \brief Keep the global indices for the next update, if the index set is updatable */
+    void storeIndices(const std::vector<char>& owned)
+    {
+      if (!previousIndices_)
+        return;
+
+      // forget the indices of entities that are no longer part of the grid view
+      previousIndices_->fill(PreviousIndex());
+      for (const auto& element : elements(gridview_))
+        for (unsigned int i=0; i<element.subEntities(codim_); i++)
+        {
+          const std::size_t idx = mapper_.subIndex(element,i,codim_);
+          (*previousIndices_)(element,i) = PreviousIndex{ globalIndex_[idx], bool(owned[idx]) };
+        }
+    }
+
   protected:
     const GridView gridview_;
 
@@ -505,11 +394,15 @@ namespace Dune
     //! Global number of entities, i.e. number of entities without rendundant entities on interprocessor boundaries
     int nGlobalEntity_;
 
-    IndexMap localGlobalMap_;
+    /** \brief Consecutive local index of the entities of codimension codim_ */
+    Mapper mapper_;
 
-    /** \brief Stores global index of entities with entity's globally unique id as key
+    /** \brief Stores global index of entities with their local index (from mapper_) as position
      */
-    MapId2Index globalIndex_;
+    std::vector<Index> globalIndex_;
+
+    /** \brief Global indices kept across grid modifications, only set for updatable index sets */
+    std::optional<PreviousIndices> previousIndices_;
   };
 
 }  // namespace Dune
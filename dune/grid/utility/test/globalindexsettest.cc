@@ -136,6 +136,51 @@ int main(int argc, char* argv[]) try
     std::cout << "Vertices" << std::endl;
   GlobalIndexSet<GridView> vertexIndexSet(gridView,2);
   checkIndexSet<GridView,2>(gridView, vertexIndexSet);
+
+  // update after refinement: no vertex is removed, so all old vertices keep their order
+  if (mpiHelper.rank() == 0)
+    std::cout << "Vertices after refinement" << std::endl;
+  GlobalIndexSet<GridView> updatableIndexSet(gridView,2,true);
+  const auto oldSize = updatableIndexSet.size(2);
+
+  grid->globalRefine(1);
+
+  const auto refinedOldToNew = updatableIndexSet.update();
+  checkIndexSet<GridView,2>(gridView, updatableIndexSet);
+
+  for (std::size_t k=0; k<refinedOldToNew.size(); k++)
+  {
+    const auto [oldIndex, newIndex] = refinedOldToNew[k];
+    if ((oldIndex < 0) || (oldIndex >= (int)oldSize) || (newIndex < oldIndex) || (newIndex >= (int)updatableIndexSet.size(2)))
+      DUNE_THROW(Exception, "Invalid pair of old and new index " << oldIndex << ", " << newIndex);
+    if ((k > 0) && (newIndex <= refinedOldToNew[k-1].second))
+      DUNE_THROW(Exception, "Old index " << oldIndex << " has changed its order to " << newIndex);
+  }
+
+  // the old vertices on this process are the vertices of the coarse grid
+  std::size_t oldVertices = 0;
+  for (const auto& vertex : vertices(grid->levelGridView(0)))
+    oldVertices += (vertex.partitionType() != GhostEntity);
+  if (refinedOldToNew.size() < oldVertices)
+    DUNE_THROW(Exception, "Only " << refinedOldToNew.size() << " of " << oldVertices << " old vertices have kept their index");
+
+  // update after load balancing
+  if (mpiHelper.rank() == 0)
+    std::cout << "Vertices after load balancing" << std::endl;
+  const auto refinedSize = updatableIndexSet.size(2);
+
+  grid->loadBalance();
+
+  const auto balancedOldToNew = updatableIndexSet.update();
+  checkIndexSet<GridView,2>(gridView, updatableIndexSet);
+
+  for (const auto& [oldIndex, newIndex] : balancedOldToNew)
+    if ((oldIndex < 0) || (oldIndex >= (int)refinedSize) || (newIndex < 0) || (newIndex >= (int)updatableIndexSet.size(2)))
+      DUNE_THROW(Exception, "Invalid pair of old and new index " << oldIndex << ", " << newIndex);
+
+  // load balancing neither creates nor removes vertices
+  if (updatableIndexSet.size(2) != refinedSize)
+    DUNE_THROW(Exception, "Wrong number of vertices " << updatableIndexSet.size(2) << " after load balancing");
 #endif
 
   return 0;
@@ -8,6 +8,10 @@
 #include <cstdint>
 #include <iostream>
 #include <iterator>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <typeindex>
 #include <vector>
 #include <algorithm>
 #include <stack>
@@ -121,24 +125,24 @@ namespace Dune {
 #ifndef DOXYGEN
   template<int dim, int codim>
   struct YaspCommunicateMeta {
-    template<class G, class DataHandle>
-    static void comm (const G& g, DataHandle& data, InterfaceType iftype, CommunicationDirection dir, int level)
+    template<class G, class DataHandle, class... Layers>
+    static void comm (const G& g, DataHandle& data, InterfaceType iftype, CommunicationDirection dir, int level, Layers... layers)
     {
       if (data.contains(dim,codim))
       {
-        g.template communicateCodim<DataHandle,codim>(data,iftype,dir,level);
+        g.template communicateCodim<DataHandle,codim>(data,iftype,dir,level,layers...);
       }
-      YaspCommunicateMeta<dim,codim-1>::comm(g,data,iftype,dir,level);
+      YaspCommunicateMeta<dim,codim-1>::comm(g,data,iftype,dir,level,layers...);
     }
   };
 
   template<int dim>
   struct YaspCommunicateMeta<dim,0> {
-    template<class G, class DataHandle>
-    static void comm (const G& g, DataHandle& data, InterfaceType iftype, CommunicationDirection dir, int level)
+    template<class G, class DataHandle, class... Layers>
+    static void comm (const G& g, DataHandle& data, InterfaceType iftype, CommunicationDirection dir, int level, Layers... layers)
     {
       if (data.contains(dim,0))
-        g.template communicateCodim<DataHandle,0>(data,iftype,dir,level);
+        g.template communicateCodim<DataHandle,0>(data,iftype,dir,level,layers...);
     }
   };
 #endif
@@ -225,6 +229,17 @@ namespace Dune {
       std::array<YGridList<Coordinates>,dim+1> recv_overlapfront_interiorborder;
       std::array<std::deque<Intersection>, Dune::power(2,dim)>  recv_overlapfront_interiorborder_data;
 
+      /** \brief send/recv lists restricted to a range of halo layers
+       *
+       *  These are built on demand by communicateCodim and are keyed by
+       *  (send partition, first layer, last layer).
+       */
+      struct HaloLists {
+        std::array<std::deque<Intersection>, dim+1> send;
+        std::array<std::deque<Intersection>, dim+1> recv;
+      };
+      mutable std::map<std::array<int,3>, HaloLists> haloLists;
+
       // general
       YaspGrid<dim,Coordinates>* mg;  // each grid level knows its multigrid
       int overlapSize;           // in mesh cells on this level
@@ -248,6 +263,31 @@ namespace Dune {
       return _torus;
     }
 
+    /** \brief Exchange data with processes on the same node through MPI-3 shared memory windows
+     *
+     *  This is transparent to data handles. The call is collective. Messages that do not fit
+     *  into the window go point-to-point; calling this again with enable=true grows the windows
+     *  to the largest messages sent so far.
+     *  \see Torus::sharedMemory
+     */
+    void sharedMemoryCommunication (bool enable, std::size_t capacity = std::size_t(1) << 20)
+    {
+      _torus.sharedMemory(enable, capacity);
+    }
+
+    /** \brief Keep communication buffers and use persistent MPI requests for repeated communication
+     *
+     *  If enabled, message buffers and MPI_Send_init/MPI_Recv_init requests are kept for each
+     *  send/recv list and data type. They are reused as long as the message sizes do not change,
+     *  so that steady-state communication only starts and completes the requests.
+     *  This trades memory for latency.
+     */
+    void persistentCommunication (bool enable)
+    {
+      _persistentComm = enable;
+      _commPlans.clear();
+    }
+
     //! return number of cells on finest level in given direction on all processors
     int globalSize(int i) const
     {
@@ -560,9 +600,18 @@ namespace Dune {
      * \returns two lists: Intersections to be sent and Intersections to be received
      */
     void intersections(const YGridComponent<Coordinates>& sendgrid, const YGridComponent<Coordinates>& recvgrid,
-                        std::deque<Intersection>& sendlist, std::deque<Intersection>& recvlist)
+                        std::deque<Intersection>& sendlist, std::deque<Intersection>& recvlist) const
+    {
+      intersections(sendgrid, recvgrid, sendlist, recvlist, globalSize());
+    }
+
+    /** \brief Construct list of intersections with neighboring processors on a grid of given global size
+     *
+     * \param size the global size of the grid level, needed to shift grids across periodic boundaries
+     */
+    void intersections(const YGridComponent<Coordinates>& sendgrid, const YGridComponent<Coordinates>& recvgrid,
+                        std::deque<Intersection>& sendlist, std::deque<Intersection>& recvlist, const iTupel& size) const
     {
-      iTupel size = globalSize();
 
       // the exchange buffers
       std::vector<YGridComponent<Coordinates> > send_recvgrid(_torus.neighbors());
@@ -727,6 +776,7 @@ namespace Dune {
      *  @param periodic tells if direction is periodic or not
      *  @param overlap size of overlap on coarsest grid (same in all directions)
      *  @param comm the communication object for this grid. An MPI communicator can be given here.
+     *              The partitioner may reorder its processes, see comm().
      *  @param partitioner pointer to an overloaded Yasp::Partitioning instance
      */
     YaspGrid (const Coordinates& coordinates,
@@ -750,6 +800,7 @@ namespace Dune {
 
       // Construct the communication torus
       _torus = decltype(_torus)(comm,tag,_coarseSize,overlap,partitioner);
+      ccobj = _torus.comm();
 
       iTupel o;
       std::fill(o.begin(), o.end(), 0);
@@ -898,6 +949,7 @@ namespace Dune {
      *  @param periodic tells if direction is periodic or not
      *  @param overlap size of overlap on coarsest grid (same in all directions)
      *  @param comm the communication object for this grid. An MPI communicator can be given here.
+     *              The partitioner may reorder its processes, see comm().
      *  @param partitioner pointer to an overloaded Yasp::Partitioning instance
      */
     template<class C = Coordinates,
@@ -912,6 +964,7 @@ namespace Dune {
         _L(L), _periodic(periodic), _coarseSize(s), _overlap(overlap),
         keep_ovlp(true), adaptRefCount(0), adaptActive(false)
     {
+      ccobj = _torus.comm();
       _levels.resize(1);
 
       iTupel o;
@@ -968,6 +1021,7 @@ namespace Dune {
      *  @param periodic tells if direction is periodic or not
      *  @param overlap size of overlap on coarsest grid (same in all directions)
      *  @param comm the communication object for this grid. An MPI communicator can be given here.
+     *              The partitioner may reorder its processes, see comm().
      *  @param partitioner pointer to an overloaded Yasp::Partitioning instance
      */
     template<class C = Coordinates,
@@ -984,6 +1038,7 @@ namespace Dune {
         _periodic(periodic), _coarseSize(s), _overlap(overlap),
         keep_ovlp(true), adaptRefCount(0), adaptActive(false)
     {
+      ccobj = _torus.comm();
       _levels.resize(1);
 
       iTupel o;
@@ -1037,6 +1092,7 @@ namespace Dune {
      *  @param periodic tells if direction is periodic or not
      *  @param overlap size of overlap on coarsest grid (same in all directions)
      *  @param comm the communication object for this grid. An MPI communicator can be given here.
+     *              The partitioner may reorder its processes, see comm().
      *  @param partitioner pointer to an overloaded Yasp::Partitioning instance
      */
     template<class C = Coordinates,
@@ -1050,6 +1106,7 @@ namespace Dune {
         leafIndexSet_(*this), _periodic(periodic), _overlap(overlap),
         keep_ovlp(true), adaptRefCount(0), adaptActive(false)
     {
+      ccobj = _torus.comm();
       if (!Dune::Yasp::checkIfMonotonous(coords))
         DUNE_THROW(Dune::GridError,"Setup of a tensorproduct grid requires monotonous sequences of coordinates.");
 
@@ -1142,7 +1199,8 @@ namespace Dune {
 
     /** @brief Constructor for a tensorproduct YaspGrid with only coordinate
      *         information on this processor
-     *  @param comm MPI communicator where this mesh is distributed to
+     *  @param comm MPI communicator where this mesh is distributed to.
+     *              The partitioner may reorder its processes, see comm().
      *  @param coords coordinate vectors to be used for coarse grid
      *  @param periodic tells if direction is periodic or not
      *  @param overlap size of overlap on coarsest grid (same in all directions)
@@ -1164,6 +1222,7 @@ namespace Dune {
         _periodic(periodic), _coarseSize(coarseSize), _overlap(overlap),
         keep_ovlp(true), adaptRefCount(0), adaptActive(false)
     {
+      ccobj = _torus.comm();
       // check whether YaspGrid has been given the correct template parameter
       static_assert(std::is_same<Coordinates,TensorProductCoordinates<ctype,dim> >::value,
                   "YaspGrid coordinate container template parameter and given constructor values do not match!");
@@ -1220,6 +1279,9 @@ namespace Dune {
         DUNE_THROW(GridError, "Only " << maxLevel() << " levels left. " <<
                    "Coarsening " << -refCount << " levels requested!");
 
+      // kept communication buffers refer to the lists of the levels
+      _commPlans.clear();
+
       // If refCount is negative then coarsen the grid
       for (int k=refCount; k<0; k++)
       {
@@ -1485,6 +1547,28 @@ namespace Dune {
       YaspCommunicateMeta<dim,dim>::comm(*this,data,iftype,dir,this->maxLevel());
     }
 
+    /*! communicate objects for all codims on a given level, restricted to a range of halo layers
+
+       Only those entities are exchanged that lie in the halo layers first+1,...,depth of the
+       receiving process. Halo layer k consists of the closure of all cells with distance k
+       (in cells of the given level) to the interior of the receiving process. With first=0,
+       the complete halo of width depth is exchanged, including the border if it is part of
+       the interface. The halo width depth must not exceed the overlap size of the level.
+
+       This allows for communication-avoiding schemes: exchange a halo of width k once and
+       advance k steps with redundant computation in the halo, or after j steps refresh only
+       the outermost j layers by passing first=depth-j.
+
+       The send/recv lists for a given layer range are computed collectively on first use
+       and are reused in subsequent calls. Only interfaces that receive into the overlap
+       (InteriorBorder_All, Overlap_OverlapFront, Overlap_All and All_All) are supported.
+     */
+    template<class DataHandleImp, class DataType>
+    void communicate (CommDataHandleIF<DataHandleImp,DataType> & data, InterfaceType iftype, CommunicationDirection dir, int level, int depth, int first = 0) const
+    {
+      YaspCommunicateMeta<dim,dim>::comm(*this,data,iftype,dir,level,depth,first);
+    }
+
     /*! The new communication interface
 
        communicate objects for one codim
@@ -1495,9 +1579,6 @@ namespace Dune {
       // check input
       if (!data.contains(dim,codim)) return; // should have been checked outside
 
-      // data types
-      typedef typename DataHandle::DataType DataType;
-
       // access to grid level
       YGridLevelIterator g = begin(level);
 
@@ -1530,16 +1611,208 @@ namespace Dune {
       if (dir==BackwardCommunication)
         std::swap(sendlist,recvlist);
 
+      communicateLists<DataHandle,codim>(data,g,*sendlist,*recvlist);
+    }
+
+    /*! communicate objects for one codim, restricted to a range of halo layers
+
+       See the communicate() method taking a halo layer range for the meaning of depth and first.
+     */
+    template<class DataHandle, int codim>
+    void communicateCodim (DataHandle& data, InterfaceType iftype, CommunicationDirection dir, int level, int depth, int first) const
+    {
+      // check input
+      if (!data.contains(dim,codim)) return; // should have been checked outside
+
+      // access to grid level
+      YGridLevelIterator g = begin(level);
+
+      if (depth < 1 || depth > g->overlapSize || first < 0 || first >= depth)
+        DUNE_THROW(GridError, "Invalid halo layer range [" << first << "," << depth << ") for overlap " << g->overlapSize);
+
+      // the halo lists are built collectively on first use and reused afterwards
+      const typename YGridLevel::HaloLists& halo = makeHaloLists(g,iftype,depth,first);
+
+      const std::deque<Intersection>* sendlist = &halo.send[codim];
+      const std::deque<Intersection>* recvlist = &halo.recv[codim];
+
+      // change communication direction?
+      if (dir==BackwardCommunication)
+        std::swap(sendlist,recvlist);
+
+      communicateLists<DataHandle,codim>(data,g,*sendlist,*recvlist);
+    }
+
+  private:
+
+    /** \brief Build (or look up) the send/recv lists of a grid level restricted to halo layers [first,depth)
+     *
+     *  The region received by a process is the closure of all cells at distance at most depth
+     *  from its interior, minus the closure of all cells at distance at most first (if first>0).
+     *  This difference of two boxes is split into 2*dim boxes per component, each of which is
+     *  intersected with the neighbors exactly like the full overlap lists in makelevel.
+     */
+    const typename YGridLevel::HaloLists& makeHaloLists (YGridLevelIterator g, InterfaceType iftype, int depth, int first) const
+    {
+      // determine which partition is sent
+      int sendpartition = 0;
+      if (iftype==InteriorBorder_All_Interface)
+        sendpartition = 0;
+      else if (iftype==Overlap_OverlapFront_Interface || iftype==Overlap_All_Interface)
+        sendpartition = 1;
+      else if (iftype==All_All_Interface)
+        sendpartition = 2;
+      else
+        DUNE_THROW(GridError, "Halo layers can only be selected for interfaces receiving into the overlap");
+
+      std::array<int,3> key = {{sendpartition, first, depth}};
+      auto it = g->haloLists.find(key);
+      if (it != g->haloLists.end())
+        return it->second;
+
+      typename YGridLevel::HaloLists& halo = g->haloLists[key];
+
+      const YGridComponent<Coordinates>& interior = *(g->interior[0].dataBegin());
+      iTupel size = levelSize(g->level());
+
+      for (int codim = 0; codim < dim+1; codim++)
+      {
+        const YGrid* sendgrid = &g->interiorborder[codim];
+        if (sendpartition == 1)
+          sendgrid = &g->overlap[codim];
+        if (sendpartition == 2)
+          sendgrid = &g->overlapfront[codim];
+
+        // iterate over the components of the codimension, keeping track of the index offset
+        int offset = 0;
+        auto sit = sendgrid->dataBegin();
+        for (auto ofit = g->overlapfront[codim].dataBegin(); ofit != g->overlapfront[codim].dataEnd(); ++ofit, ++sit)
+        {
+          std::vector<YGridComponent<Coordinates> > pieces = haloPieces(*ofit,interior,depth,first);
+          for (const auto& piece : pieces)
+          {
+            std::deque<Intersection> sendlist, recvlist;
+            intersections(*sit,piece,sendlist,recvlist,size);
+
+            for (const auto& is : sendlist)
+            {
+              halo.send[codim].push_back(is);
+              halo.send[codim].back().yg.setBegin(&halo.send[codim].back().grid);
+              halo.send[codim].back().yg.finalize(&halo.send[codim].back().grid+1,offset);
+            }
+            for (const auto& is : recvlist)
+            {
+              halo.recv[codim].push_back(is);
+              halo.recv[codim].back().yg.setBegin(&halo.recv[codim].back().grid);
+              halo.recv[codim].back().yg.finalize(&halo.recv[codim].back().grid+1,offset);
+            }
+          }
+
+          offset += ofit->totalsize();
+        }
+      }
+
+      return halo;
+    }
+
+    /** \brief Split the halo layers [first,depth) of an overlapfront component into boxes
+     *
+     *  Returns a single box if first==0 and 2*dim (possibly empty) boxes otherwise, so that
+     *  all processes perform the same number of collective intersection computations.
+     */
+    static std::vector<YGridComponent<Coordinates> > haloPieces (const YGridComponent<Coordinates>& overlapfront,
+                                                                  const YGridComponent<Coordinates>& interior,
+                                                                  int depth, int first)
+    {
+      // closure of all cells at distance at most m from the interior, clipped to the local grid
+      auto grown = [&](int m) {
+        iTupel origin, size;
+        for (int i=0; i<dim; i++)
+        {
+          origin[i] = interior.origin(i) - m;
+          size[i] = interior.size(i) + 2*m + (overlapfront.shift(i) ? 0 : 1);
+        }
+        return overlapfront.intersection(YGridComponent<Coordinates>(origin,size));
+      };
+
+      std::vector<YGridComponent<Coordinates> > pieces;
+      YGridComponent<Coordinates> outer = grown(depth);
+      if (first == 0)
+      {
+        pieces.push_back(outer);
+        return pieces;
+      }
+
+      // peel off the inner box direction by direction
+      YGridComponent<Coordinates> inner = grown(first);
+      iTupel origin = outer.origin();
+      iTupel size = outer.size();
+      for (int i=0; i<dim; i++)
+      {
+        iTupel o(origin), s(size);
+        s[i] = inner.origin(i) - origin[i];
+        pieces.push_back(YGridComponent<Coordinates>(o,s,overlapfront));
+
+        o[i] = inner.max(i) + 1;
+        s[i] = origin[i] + size[i] - o[i];
+        pieces.push_back(YGridComponent<Coordinates>(o,s,overlapfront));
+
+        origin[i] = inner.origin(i);
+        size[i] = inner.size(i);
+      }
+      return pieces;
+    }
+
+    /** \brief Message buffers and persistent requests for communication over a pair of send/recv lists
+     */
+    struct CommPlan {
+      typename Torus<Communication,dim>::PersistentRequests sizeRequests;
+      typename Torus<Communication,dim>::PersistentRequests dataRequests;
+      std::vector<std::vector<size_t> > sendSizes;  // number of objects per entity to be sent
+      std::vector<std::vector<size_t> > recvSizes;  // number of objects per entity to be recvd
+      std::vector<std::shared_ptr<void> > sends;    // send buffers
+      std::vector<std::shared_ptr<void> > recvs;    // recv buffers
+      std::vector<int> sendCounts;                  // number of objects the send buffers hold
+      std::vector<int> recvCounts;                  // number of objects the recv buffers hold
+    };
+
+    //! exchange data for all entities in the given send and recv lists
+    template<class DataHandle, int codim, class List>
+    void communicateLists (DataHandle& data, YGridLevelIterator g, const List& sendlist_, const List& recvlist_) const
+    {
+      // data types
+      typedef typename DataHandle::DataType DataType;
+
+      const List* sendlist = &sendlist_;
+      const List* recvlist = &recvlist_;
+
       int cnt;
 
+      // buffers and requests are kept across calls in persistent mode
+      CommPlan temporary;
+      CommPlan& plan = _persistentComm
+        ? _commPlans[std::make_tuple(static_cast<const void*>(sendlist), static_cast<const void*>(recvlist), std::type_index(typeid(DataType)))]
+        : temporary;
+      auto exchange = [&](typename Torus<Communication,dim>::PersistentRequests& requests) {
+        if (_persistentComm)
+          torus().exchange(requests);
+        else
+          torus().exchange();
+      };
+
+      plan.sendSizes.resize(sendlist->size());
+      plan.recvSizes.resize(recvlist->size());
+      plan.sends.resize(sendlist->size());
+      plan.recvs.resize(recvlist->size());
+      plan.sendCounts.resize(sendlist->size(),-1);
+      plan.recvCounts.resize(recvlist->size(),-1);
+
       // Size computation (requires communication if variable size)
       std::vector<int> send_size(sendlist->size(),-1);    // map rank to total number of objects (of type DataType) to be sent
       std::vector<int> recv_size(recvlist->size(),-1);    // map rank to total number of objects (of type DataType) to be recvd
-      std::vector<size_t*> send_sizes(sendlist->size(),static_cast<size_t*>(0)); // map rank to array giving number of objects per entity to be sent
-      std::vector<size_t*> recv_sizes(recvlist->size(),static_cast<size_t*>(0)); // map rank to array giving number of objects per entity to be recvd
 
       // define type to iterate over send and recv lists
-      typedef typename YGridList<Coordinates>::Iterator ListIt;
+      typedef decltype(sendlist->begin()) ListIt;
 
       if (data.fixedSize(dim,codim))
       {
@@ -1568,8 +1841,8 @@ namespace Dune {
         for (ListIt is=sendlist->begin(); is!=sendlist->end(); ++is)
         {
           // allocate send buffer for sizes per entity
-          size_t *buf = new size_t[is->grid.totalsize()];
-          send_sizes[cnt] = buf;
+          plan.sendSizes[cnt].resize(is->grid.totalsize());
+          size_t *buf = plan.sendSizes[cnt].data();
 
           // loop over entities and ask for size
           int i=0; size_t n=0;
@@ -1597,8 +1870,8 @@ namespace Dune {
         for (ListIt is=recvlist->begin(); is!=recvlist->end(); ++is)
         {
           // allocate recv buffer
-          size_t *buf = new size_t[is->grid.totalsize()];
-          recv_sizes[cnt] = buf;
+          plan.recvSizes[cnt].resize(is->grid.totalsize());
+          size_t *buf = plan.recvSizes[cnt].data();
 
           // hand over recv request to torus class
           torus().recv(is->rank,buf,is->grid.totalsize()*sizeof(size_t));
@@ -1606,23 +1879,14 @@ namespace Dune {
         }
 
         // exchange all size buffers now
-        torus().exchange();
-
-        // release send size buffers
-        cnt=0;
-        for (ListIt is=sendlist->begin(); is!=sendlist->end(); ++is)
-        {
-          delete[] send_sizes[cnt];
-          send_sizes[cnt] = 0;
-          cnt++;
-        }
+        exchange(plan.sizeRequests);
 
         // process receive size buffers
         cnt=0;
         for (ListIt is=recvlist->begin(); is!=recvlist->end(); ++is)
         {
           // get recv buffer
-          size_t *buf = recv_sizes[cnt];
+          const size_t *buf = plan.recvSizes[cnt].data();
 
           // compute total size
           size_t n=0;
@@ -1637,15 +1901,16 @@ namespace Dune {
 
 
       // allocate & fill the send buffers & store send request
-      std::vector<DataType*> sends(sendlist->size(), static_cast<DataType*>(0)); // store pointers to send buffers
       cnt=0;
       for (ListIt is=sendlist->begin(); is!=sendlist->end(); ++is)
       {
-        // allocate send buffer
-        DataType *buf = new DataType[send_size[cnt]];
-
-        // remember send buffer
-        sends[cnt] = buf;
+        // allocate send buffer, unless the one of the previous call has the right size
+        if (plan.sendCounts[cnt] != send_size[cnt])
+        {
+          plan.sends[cnt] = std::shared_ptr<DataType[]>(new DataType[send_size[cnt]]);
+          plan.sendCounts[cnt] = send_size[cnt];
+        }
+        DataType *buf = static_cast<DataType*>(plan.sends[cnt].get());
 
         // make a message buffer
         MessageBuffer<DataType> mb(buf);
@@ -1664,15 +1929,16 @@ namespace Dune {
       }
 
       // allocate recv buffers and store receive request
-      std::vector<DataType*> recvs(recvlist->size(),static_cast<DataType*>(0)); // store pointers to send buffers
       cnt=0;
       for (ListIt is=recvlist->begin(); is!=recvlist->end(); ++is)
       {
-        // allocate recv buffer
-        DataType *buf = new DataType[recv_size[cnt]];
-
-        // remember recv buffer
-        recvs[cnt] = buf;
+        // allocate recv buffer, unless the one of the previous call has the right size
+        if (plan.recvCounts[cnt] != recv_size[cnt])
+        {
+          plan.recvs[cnt] = std::shared_ptr<DataType[]>(new DataType[recv_size[cnt]]);
+          plan.recvCounts[cnt] = recv_size[cnt];
+        }
+        DataType *buf = static_cast<DataType*>(plan.recvs[cnt].get());
 
         // hand over recv request to torus class
         torus().recv(is->rank,buf,recv_size[cnt]*sizeof(DataType));
@@ -1680,23 +1946,14 @@ namespace Dune {
       }
 
       // exchange all buffers now
-      torus().exchange();
+      exchange(plan.dataRequests);
 
-      // release send buffers
-      cnt=0;
-      for (ListIt is=sendlist->begin(); is!=sendlist->end(); ++is)
-      {
-        delete[] sends[cnt];
-        sends[cnt] = 0;
-        cnt++;
-      }
-
-      // process receive buffers and delete them
+      // process receive buffers
       cnt=0;
       for (ListIt is=recvlist->begin(); is!=recvlist->end(); ++is)
       {
         // get recv buffer
-        DataType *buf = recvs[cnt];
+        DataType *buf = static_cast<DataType*>(plan.recvs[cnt].get());
 
         // make a message buffer
         MessageBuffer<DataType> mb(buf);
@@ -1715,22 +1972,21 @@ namespace Dune {
         else
         {
           int i=0;
-          size_t *sbuf = recv_sizes[cnt];
+          const size_t *sbuf = plan.recvSizes[cnt].data();
           typename Traits::template Codim<codim>::template Partition<All_Partition>::LevelIterator
           it(YaspLevelIterator<codim,All_Partition,GridImp>(g, typename YGrid::Iterator(is->yg)));
           typename Traits::template Codim<codim>::template Partition<All_Partition>::LevelIterator
           itend(YaspLevelIterator<codim,All_Partition,GridImp>(g, typename YGrid::Iterator(is->yg,true)));
           for ( ; it!=itend; ++it)
             data.scatter(mb,*it,sbuf[i++]);
-          delete[] sbuf;
         }
 
-        // delete buffer
-        delete[] buf; // hier krachts !
         cnt++;
       }
     }
 
+  public:
+
     // The new index sets from DDM 11.07.2005
     const typename Traits::GlobalIdSet& globalIdSet() const
     {
@@ -1754,6 +2010,10 @@ namespace Dune {
     }
 
     /*! @brief return a communication object
+     *
+     *  This is the communicator of the process torus, see torus(). With node-aware placement
+     *  (Yasp::NodeAwarePartitioning) it is a reordered copy of the communicator passed to the
+     *  constructor, so the rank of a process may differ from its rank in the original one.
      */
     const Communication& comm () const
     {
@@ -1864,6 +2124,8 @@ namespace Dune {
     std::bitset<dim> _periodic;
     iTupel _coarseSize;
     ReservedVector<YGridLevel,32> _levels;
+    bool _persistentComm = false;
+    mutable std::map<std::tuple<const void*, const void*, std::type_index>, CommPlan> _commPlans;
     int _overlap;
     bool keep_ovlp;
     int adaptRefCount;
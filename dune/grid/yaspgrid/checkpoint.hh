@@ -0,0 +1,723 @@
+// SPDX-FileCopyrightText: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_YASPGRID_CHECKPOINT_HH
+#define DUNE_GRID_YASPGRID_CHECKPOINT_HH
+
+/** \file
+ *  \brief Collective single-file checkpoint of a YaspGrid and the data attached to its entities
+ */
+
+//- system headers
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if HAVE_MPI
+#include <mpi.h>
+#endif
+
+//- Dune headers
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/hybridutilities.hh>
+#include <dune/grid/common/exceptions.hh>
+#include <dune/grid/yaspgrid.hh>
+
+// bump this version number up if you introduce any changes
+// to the file format of the YaspCheckpoint.
+#define YASPGRID_CHECKPOINT_FORMAT_VERSION 1
+
+namespace Dune
+{
+
+  template<class Grid>
+  class YaspCheckpoint;
+
+  /** \brief Collective single-file checkpoint of a YaspGrid and user data attached to its leaf entities
+   *
+   *  All processes write into one binary file.  The file starts with a header holding
+   *  the grid descriptor (coarse coordinates, periodicity, overlap, refinement history)
+   *  and an index of the registered data arrays, followed by one block per array.
+   *  The data of an array is stored in a global, lexicographic numbering of the leaf
+   *  entities which does not depend on the partitioning.  Every entity is written once
+   *  by the process owning it, and every process reads the entries of all its entities,
+   *  including the overlap.  A checkpoint can therefore be read back on any number of
+   *  processes.  With MPI the file is accessed with collective MPI-IO, without MPI
+   *  the same layout is written with a std::fstream.
+   *
+   *  Usage:
+   *  \code
+   *  Dune::PersistentContainer<Grid,double> pressure(grid, 0);
+   *  Dune::YaspCheckpoint<Grid> checkpoint("state.ckpt");
+   *  checkpoint.add("pressure", pressure);
+   *  checkpoint.write(grid);
+   *
+   *  // later, possibly on a different number of processes
+   *  Dune::YaspCheckpoint<Grid> restart("state.ckpt");
+   *  std::unique_ptr<Grid> newGrid(restart.restoreGrid(comm));
+   *  Dune::PersistentContainer<Grid,double> newPressure(*newGrid, 0);
+   *  restart.add("pressure", newPressure);
+   *  restart.read(*newGrid);
+   *  \endcode
+   *
+   *  Containers are registered by reference and have to provide the interface of
+   *  a PersistentContainer: \c codimension(), \c resize() and \c operator[] for
+   *  entities.  Their value type must be trivially copyable; values are stored
+   *  bytewise in the native representation.
+   */
+  template<int dim, class Coordinates>
+  class YaspCheckpoint<YaspGrid<dim, Coordinates> >
+  {
+  public:
+    typedef YaspGrid<dim, Coordinates> Grid;
+    typedef typename Grid::ctype ctype;
+    typedef typename Grid::Communication Communication;
+
+    //! maximum length of the name of a data array, including the terminating zero
+    static const std::size_t nameLength = 64;
+
+    //! data blocks start at multiples of this number of bytes
+    static const std::uint64_t alignment = 4096;
+
+    /** \brief create a checkpoint stored in the given file
+     *  \param filename the name of the checkpoint file, the same on all processes
+     */
+    explicit YaspCheckpoint (const std::string& filename)
+      : _filename(filename)
+    {}
+
+    /** \brief register a container with data on the leaf entities
+     *
+     *  \param name the name of the array in the checkpoint file
+     *  \param container a PersistentContainer or an object with the same interface
+     */
+    template<class Container>
+    void add (const std::string& name, Container& container)
+    {
+      typedef typename Container::Value Value;
+      static_assert(std::is_trivially_copyable<Value>::value,
+                    "YaspCheckpoint can only store trivially copyable values");
+
+      if (name.empty() || name.size() >= nameLength)
+        DUNE_THROW(RangeError, "YaspCheckpoint: the array name '" << name << "' is empty or too long");
+      for (const auto& array : _arrays)
+        if (array.name == name)
+          DUNE_THROW(RangeError, "YaspCheckpoint: an array named '" << name << "' was already added");
+
+      Array array;
+      array.name = name;
+      array.codim = container.codimension();
+      array.bytes = sizeof(Value);
+      array.resize = [&container] () { container.resize(); };
+      array.forEach = [&container, codim = array.codim] (const Grid& grid, const Visitor& visitor)
+      {
+        Hybrid::forEach(std::make_index_sequence<dim+1>{}, [&](auto cc)
+        {
+          if (int(cc) != codim)
+            return;
+          for (const auto& e : entities(grid.leafGridView(), Codim<decltype(cc)::value>{}))
+          {
+            const auto& it = e.impl().transformingsubiterator();
+            visitor(it.coord(), it.shift(), reinterpret_cast<char*>(&container[e]));
+          }
+        });
+      };
+      _arrays.push_back(std::move(array));
+    }
+
+    /** \brief write the grid and all registered arrays
+     *
+     *  This method is collective on the communicator of the grid.
+     */
+    void write (const Grid& grid) const
+    {
+      const Descriptor descriptor = describe(grid);
+
+      std::vector<Entry> entries;
+      const std::vector<char> header = makeHeader(descriptor, entries);
+
+      File file(grid.comm(), _filename, true);
+      if (grid.comm().rank() == 0)
+        file.writeAt(0, header.data(), header.size());
+
+      const auto& g = *grid.begin(grid.maxLevel());
+      for (std::size_t a=0; a<_arrays.size(); a++)
+      {
+        const Array& array = _arrays[a];
+
+        // collect the entries of all entities owned by this process
+        std::vector<std::uint64_t> indices;
+        std::vector<char> values;
+        array.forEach(grid, [&](const iTupel& coord, const std::bitset<dim>& shift, const char* value)
+        {
+          if (!owned(g, descriptor, coord, shift))
+            return;
+          indices.push_back(descriptor.index(coord, shift));
+          values.insert(values.end(), value, value + array.bytes);
+        });
+
+        // sort them by their global index
+        std::vector<std::size_t> permutation(indices.size());
+        std::iota(permutation.begin(), permutation.end(), 0);
+        std::sort(permutation.begin(), permutation.end(),
+                  [&](std::size_t i, std::size_t j) { return indices[i] < indices[j]; });
+
+        std::vector<std::uint64_t> sorted(indices.size());
+        std::vector<char> buffer(values.size());
+        for (std::size_t i=0; i<permutation.size(); i++)
+        {
+          sorted[i] = indices[permutation[i]];
+          std::memcpy(buffer.data() + i*array.bytes, values.data() + permutation[i]*array.bytes, array.bytes);
+        }
+
+        file.writeAll(entries[a].offset, array.bytes, sorted, buffer.data());
+      }
+    }
+
+    /** \brief create the grid stored in the checkpoint
+     *
+     *  The grid is distributed with the default partitioner among the processes
+     *  of the given communicator, whose size may differ from the one used for writing.
+     *  This method is collective on the communicator.
+     *
+     *  \returns a pointer to a new grid, the caller takes ownership
+     */
+    Grid* restoreGrid (Communication comm = Communication()) const
+    {
+      File file(comm, _filename, false);
+      std::vector<Entry> entries;
+      const Descriptor descriptor = readHeader(file, comm, entries);
+
+      Grid* grid = createGrid(static_cast<const Coordinates*>(nullptr), descriptor, comm);
+      for (std::size_t l=0; l<descriptor.keepOverlap.size(); l++)
+      {
+        grid->refineOptions(descriptor.keepOverlap[l]);
+        grid->globalRefine(1);
+      }
+      return grid;
+    }
+
+    /** \brief read all registered arrays
+     *
+     *  The containers are resized and their values on all leaf entities, including
+     *  overlap and ghost entities, are set from the checkpoint.  The grid must have
+     *  the same global structure as the one written.
+     *  This method is collective on the communicator of the grid.
+     */
+    void read (const Grid& grid) const
+    {
+      File file(grid.comm(), _filename, false);
+      std::vector<Entry> entries;
+      const Descriptor descriptor = readHeader(file, grid.comm(), entries);
+
+      for (int i=0; i<dim; i++)
+        if (descriptor.size(i) != grid.globalSize(i) || descriptor.periodic[i] != grid.isPeriodic(i))
+          DUNE_THROW(GridError, "YaspCheckpoint: the grid does not match the one stored in '" << _filename << "'");
+
+      for (const Array& array : _arrays)
+      {
+        auto entry = std::find_if(entries.begin(), entries.end(),
+                                  [&](const Entry& e) { return e.name == array.name; });
+        if (entry == entries.end())
+          DUNE_THROW(IOError, "YaspCheckpoint: no array '" << array.name << "' in '" << _filename << "'");
+        if (entry->codim != std::uint64_t(array.codim) || entry->bytes != array.bytes)
+          DUNE_THROW(IOError, "YaspCheckpoint: the array '" << array.name << "' in '" << _filename
+                     << "' has a different codimension or value size");
+
+        array.resize();
+
+        // the sorted global indices of all entities on this process
+        std::vector<std::uint64_t> indices;
+        array.forEach(grid, [&](const iTupel& coord, const std::bitset<dim>& shift, char*)
+        {
+          indices.push_back(descriptor.index(coord, shift));
+        });
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+        std::vector<char> buffer(indices.size() * array.bytes);
+        file.readAll(entry->offset, array.bytes, indices, buffer.data());
+
+        array.forEach(grid, [&](const iTupel& coord, const std::bitset<dim>& shift, char* value)
+        {
+          auto pos = std::lower_bound(indices.begin(), indices.end(), descriptor.index(coord, shift));
+          std::memcpy(value, buffer.data() + (pos - indices.begin())*array.bytes, array.bytes);
+        });
+      }
+    }
+
+  private:
+    typedef std::array<int, dim> iTupel;
+    typedef std::function<void(const iTupel&, const std::bitset<dim>&, char*)> Visitor;
+
+    /* The checkpoint file, opened by all processes of a communicator.
+     * Data is written and read in runs of consecutive global indices.
+     */
+    class File
+    {
+    public:
+      File (const Communication& comm, const std::string& filename, bool write)
+        : _filename(filename)
+      {
+#if HAVE_MPI
+        const int mode = write ? (MPI_MODE_CREATE | MPI_MODE_WRONLY) : MPI_MODE_RDONLY;
+        if (MPI_File_open(comm, filename.c_str(), mode, MPI_INFO_NULL, &_file) != MPI_SUCCESS)
+          DUNE_THROW(IOError, "YaspCheckpoint: could not open '" << filename << "'");
+        if (write)
+          MPI_File_set_size(_file, 0);
+#else
+        (void) comm;
+        _file.open(filename, write ? (std::ios::out | std::ios::binary | std::ios::trunc)
+                                   : (std::ios::in | std::ios::binary));
+        if (!_file)
+          DUNE_THROW(IOError, "YaspCheckpoint: could not open '" << filename << "'");
+#endif
+      }
+
+      File (const File&) = delete;
+      File& operator= (const File&) = delete;
+
+      ~File ()
+      {
+#if HAVE_MPI
+        MPI_File_close(&_file);
+#endif
+      }
+
+      //! write a contiguous block of bytes, independent
+      void writeAt (std::uint64_t offset, const char* data, std::size_t size)
+      {
+#if HAVE_MPI
+        check(MPI_File_write_at(_file, offset, data, size, MPI_BYTE, MPI_STATUS_IGNORE));
+#else
+        _file.seekp(offset);
+        _file.write(data, size);
+        check();
+#endif
+      }
+
+      //! read a contiguous block of bytes, independent
+      void readAt (std::uint64_t offset, char* data, std::size_t size)
+      {
+#if HAVE_MPI
+        check(MPI_File_read_at(_file, offset, data, size, MPI_BYTE, MPI_STATUS_IGNORE));
+#else
+        _file.seekg(offset);
+        _file.read(data, size);
+        check();
+#endif
+      }
+
+      //! write the entries with the given sorted global indices of a block, collective
+      void writeAll (std::uint64_t offset, std::size_t bytes, const std::vector<std::uint64_t>& indices, const char* data)
+      {
+#if HAVE_MPI
+        MPI_Datatype entry, filetype;
+        makeTypes(bytes, indices, entry, filetype);
+        MPI_File_set_view(_file, offset, entry, filetype, "native", MPI_INFO_NULL);
+        const int result = MPI_File_write_all(_file, data, indices.size(), entry, MPI_STATUS_IGNORE);
+        MPI_Type_free(&filetype);
+        MPI_Type_free(&entry);
+        check(result);
+#else
+        for (std::size_t i=0; i<indices.size(); )
+        {
+          const std::size_t n = run(indices, i);
+          writeAt(offset + indices[i]*bytes, data + i*bytes, n*bytes);
+          i += n;
+        }
+#endif
+      }
+
+      //! read the entries with the given sorted global indices of a block, collective
+      void readAll (std::uint64_t offset, std::size_t bytes, const std::vector<std::uint64_t>& indices, char* data)
+      {
+#if HAVE_MPI
+        MPI_Datatype entry, filetype;
+        makeTypes(bytes, indices, entry, filetype);
+        MPI_File_set_view(_file, offset, entry, filetype, "native", MPI_INFO_NULL);
+        const int result = MPI_File_read_all(_file, data, indices.size(), entry, MPI_STATUS_IGNORE);
+        MPI_Type_free(&filetype);
+        MPI_Type_free(&entry);
+        check(result);
+#else
+        for (std::size_t i=0; i<indices.size(); )
+        {
+          const std::size_t n = run(indices, i);
+          readAt(offset + indices[i]*bytes, data + i*bytes, n*bytes);
+          i += n;
+        }
+#endif
+      }
+
+    private:
+      // length of the run of consecutive indices starting at position i
+      static std::size_t run (const std::vector<std::uint64_t>& indices, std::size_t i)
+      {
+        std::size_t n = 1;
+        while (i+n < indices.size() && indices[i+n] == indices[i]+n
+               && n < std::size_t(std::numeric_limits<int>::max()))
+          n++;
+        return n;
+      }
+
+#if HAVE_MPI
+      // the file view selecting the entries with the given indices, in units of whole entries
+      static void makeTypes (std::size_t bytes, const std::vector<std::uint64_t>& indices,
+                             MPI_Datatype& entry, MPI_Datatype& filetype)
+      {
+        MPI_Type_contiguous(bytes, MPI_BYTE, &entry);
+        MPI_Type_commit(&entry);
+
+        std::vector<int> lengths;
+        std::vector<MPI_Aint> displacements;
+        for (std::size_t i=0; i<indices.size(); )
+        {
+          const std::size_t n = run(indices, i);
+          lengths.push_back(n);
+          displacements.push_back(indices[i]*bytes);
+          i += n;
+        }
+        MPI_Type_create_hindexed(lengths.size(), lengths.data(), displacements.data(), entry, &filetype);
+        MPI_Type_commit(&filetype);
+      }
+
+      void check (int result) const
+      {
+        if (result != MPI_SUCCESS)
+          DUNE_THROW(IOError, "YaspCheckpoint: I/O error on '" << _filename << "'");
+      }
+
+      MPI_File _file;
+#else
+      void check ()
+      {
+        if (!_file)
+          DUNE_THROW(IOError, "YaspCheckpoint: I/O error on '" << _filename << "'");
+      }
+
+      std::fstream _file;
+#endif
+      std::string _filename;
+    };
+
+    struct Array
+    {
+      std::string name;
+      int codim;
+      std::size_t bytes;
+      std::function<void()> resize;
+      std::function<void(const Grid&, const Visitor&)> forEach;
+    };
+
+    // index entry of an array in the file header
+    struct Entry
+    {
+      std::string name;
+      std::uint64_t codim;
+      std::uint64_t bytes;
+      std::uint64_t count;
+      std::uint64_t offset;
+    };
+
+    // the global structure of the grid
+    struct Descriptor
+    {
+      iTupel coarseSize;
+      std::bitset<dim> periodic;
+      int overlap;
+      std::vector<bool> keepOverlap;
+      std::array<std::vector<double>, dim> coords;
+
+      // number of cells on the finest level in direction i
+      int size (int i) const
+      {
+        return coarseSize[i] << keepOverlap.size();
+      }
+
+      // number of entities of the component with the given shift in direction i
+      std::uint64_t extent (int i, const std::bitset<dim>& shift) const
+      {
+        return size(i) + ((shift[i] || periodic[i]) ? 0 : 1);
+      }
+
+      // number of entities of the component with the given shift
+      std::uint64_t count (const std::bitset<dim>& shift) const
+      {
+        std::uint64_t n = 1;
+        for (int i=0; i<dim; i++)
+          n *= extent(i, shift);
+        return n;
+      }
+
+      // number of leaf entities of the given codimension
+      std::uint64_t count (int codim) const
+      {
+        std::uint64_t n = 0;
+        for (unsigned int s=0; s<(1u<<dim); s++)
+          if (dim - int(std::bitset<dim>(s).count()) == codim)
+            n += count(std::bitset<dim>(s));
+        return n;
+      }
+
+      // global index of a leaf entity: components are numbered by increasing shift,
+      // entities within a component lexicographically, periodic copies are identified
+      std::uint64_t index (const iTupel& coord, const std::bitset<dim>& shift) const
+      {
+        const int codim = dim - shift.count();
+        std::uint64_t offset = 0;
+        for (unsigned int s=0; s<shift.to_ulong(); s++)
+          if (dim - int(std::bitset<dim>(s).count()) == codim)
+            offset += count(std::bitset<dim>(s));
+
+        std::uint64_t index = 0;
+        for (int i=dim-1; i>=0; i--)
+        {
+          const std::int64_t n = extent(i, shift);
+          index = index * n + ((coord[i] % n) + n) % n;
+        }
+        return offset + index;
+      }
+    };
+
+    // Each entity is written by exactly one process: the one whose interior cells
+    // contain it, with upper boundary entities of non-periodic directions belonging
+    // to the last process in that direction.
+    static bool owned (const typename Grid::YGridLevel& g, const Descriptor& descriptor,
+                       const iTupel& coord, const std::bitset<dim>& shift)
+    {
+      const auto& interior = *g.interior[0].dataBegin();
+      for (int i=0; i<dim; i++)
+      {
+        const int begin = interior.origin(i);
+        const int end = begin + interior.size(i);
+        if (coord[i] >= begin && coord[i] < end)
+          continue;
+        if (!shift[i] && !descriptor.periodic[i] && coord[i] == end && end == descriptor.size(i))
+          continue;
+        return false;
+      }
+      return true;
+    }
+
+    // collect the global structure of the grid, collective
+    static Descriptor describe (const Grid& grid)
+    {
+      Descriptor descriptor;
+      for (int i=0; i<dim; i++)
+      {
+        descriptor.coarseSize[i] = grid.levelSize(0,i);
+        descriptor.periodic[i] = grid.isPeriodic(i);
+      }
+      descriptor.overlap = grid.overlapSize(0,0);
+      for (auto it = std::next(grid.begin()); it != grid.end(); ++it)
+        descriptor.keepOverlap.push_back(it->keepOverlap);
+
+      // each process knows the coarse coordinates of its part of the grid only
+      for (int i=0; i<dim; i++)
+        descriptor.coords[i].assign(descriptor.coarseSize[i]+1, std::numeric_limits<double>::lowest());
+      for (const auto& v : vertices(grid.levelGridView(0)))
+      {
+        const auto& coord = v.impl().transformingsubiterator().coord();
+        const auto x = v.geometry().corner(0);
+        for (int i=0; i<dim; i++)
+          if (coord[i] >= 0 && coord[i] <= descriptor.coarseSize[i])
+            descriptor.coords[i][coord[i]] = x[i];
+      }
+      for (int i=0; i<dim; i++)
+        grid.comm().max(descriptor.coords[i].data(), descriptor.coords[i].size());
+
+      return descriptor;
+    }
+
+    template<class T>
+    static void append (std::vector<char>& buffer, const T& value)
+    {
+      const char* p = reinterpret_cast<const char*>(&value);
+      buffer.insert(buffer.end(), p, p + sizeof(T));
+    }
+
+    template<class T>
+    static T extract (const std::vector<char>& buffer, std::size_t& pos)
+    {
+      if (pos + sizeof(T) > buffer.size())
+        DUNE_THROW(IOError, "YaspCheckpoint: truncated header");
+      T value;
+      std::memcpy(&value, buffer.data() + pos, sizeof(T));
+      pos += sizeof(T);
+      return value;
+    }
+
+    static const char* magic ()
+    {
+      return "DUNE-YASP-CKPT";
+    }
+
+    static const std::size_t magicLength = 16;
+
+    // the size of the fixed part of the header: magic, version and header size
+    static const std::size_t prefixLength = magicLength + 2*sizeof(std::uint64_t);
+
+    std::vector<char> makeHeader (const Descriptor& descriptor, std::vector<Entry>& entries) const
+    {
+      std::vector<char> header(magicLength, '\0');
+      std::strncpy(header.data(), magic(), magicLength);
+      append<std::uint64_t>(header, YASPGRID_CHECKPOINT_FORMAT_VERSION);
+      append<std::uint64_t>(header, 0);  // header size, filled in below
+
+      append<std::uint64_t>(header, dim);
+      append<std::uint64_t>(header, descriptor.keepOverlap.size());
+      append<std::uint64_t>(header, descriptor.overlap);
+      append<std::uint64_t>(header, descriptor.periodic.to_ulong());
+      for (int i=0; i<dim; i++)
+        append<std::uint64_t>(header, descriptor.coarseSize[i]);
+      for (bool keep : descriptor.keepOverlap)
+        append<std::uint64_t>(header, keep);
+      for (int i=0; i<dim; i++)
+        for (double x : descriptor.coords[i])
+          append<double>(header, x);
+
+      append<std::uint64_t>(header, _arrays.size());
+      const std::size_t headerSize = header.size()
+                                     + _arrays.size() * (nameLength + 4*sizeof(std::uint64_t));
+
+      std::uint64_t offset = headerSize;
+      entries.clear();
+      for (const Array& array : _arrays)
+      {
+        offset = (offset + alignment - 1) / alignment * alignment;
+        Entry entry{array.name, std::uint64_t(array.codim), array.bytes, descriptor.count(array.codim), offset};
+        offset += entry.count * entry.bytes;
+
+        std::array<char, nameLength> name;
+        name.fill('\0');
+        std::copy(array.name.begin(), array.name.end(), name.begin());
+        header.insert(header.end(), name.begin(), name.end());
+        append(header, entry.codim);
+        append(header, entry.bytes);
+        append(header, entry.count);
+        append(header, entry.offset);
+        entries.push_back(entry);
+      }
+
+      const std::uint64_t size = header.size();
+      std::memcpy(header.data() + magicLength + sizeof(std::uint64_t), &size, sizeof(size));
+      return header;
+    }
+
+    // read the header on the first process and distribute it, collective
+    Descriptor readHeader (File& file, const Communication& comm, std::vector<Entry>& entries) const
+    {
+      std::vector<char> header;
+      std::uint64_t size = 0;
+      if (comm.rank() == 0)
+      {
+        header.resize(prefixLength);
+        file.readAt(0, header.data(), header.size());
+        std::size_t pos = magicLength;
+        const std::uint64_t version = extract<std::uint64_t>(header, pos);
+        if (std::strncmp(header.data(), magic(), magicLength) == 0
+            && version == YASPGRID_CHECKPOINT_FORMAT_VERSION)
+          size = extract<std::uint64_t>(header, pos);
+      }
+      comm.broadcast(&size, 1, 0);
+      if (size < prefixLength)
+        DUNE_THROW(IOError, "YaspCheckpoint: '" << _filename << "' is not a checkpoint written in the current format");
+
+      header.resize(size);
+      if (comm.rank() == 0)
+        file.readAt(0, header.data(), header.size());
+      comm.broadcast(header.data(), header.size(), 0);
+
+      std::size_t pos = prefixLength;
+      if (extract<std::uint64_t>(header, pos) != std::uint64_t(dim))
+        DUNE_THROW(IOError, "YaspCheckpoint: '" << _filename << "' holds a grid of a different dimension");
+
+      Descriptor descriptor;
+      const std::uint64_t levels = extract<std::uint64_t>(header, pos);
+      descriptor.overlap = extract<std::uint64_t>(header, pos);
+      descriptor.periodic = std::bitset<dim>(extract<std::uint64_t>(header, pos));
+      for (int i=0; i<dim; i++)
+        descriptor.coarseSize[i] = extract<std::uint64_t>(header, pos);
+      for (std::uint64_t l=0; l<levels; l++)
+        descriptor.keepOverlap.push_back(extract<std::uint64_t>(header, pos));
+      for (int i=0; i<dim; i++)
+      {
+        descriptor.coords[i].resize(descriptor.coarseSize[i]+1);
+        for (double& x : descriptor.coords[i])
+          x = extract<double>(header, pos);
+      }
+
+      const std::uint64_t n = extract<std::uint64_t>(header, pos);
+      entries.clear();
+      for (std::uint64_t a=0; a<n; a++)
+      {
+        if (pos + nameLength > header.size())
+          DUNE_THROW(IOError, "YaspCheckpoint: truncated header");
+        Entry entry;
+        const char* name = header.data() + pos;
+        entry.name = std::string(name, std::find(name, name + nameLength, '\0'));
+        pos += nameLength;
+        entry.codim = extract<std::uint64_t>(header, pos);
+        entry.bytes = extract<std::uint64_t>(header, pos);
+        entry.count = extract<std::uint64_t>(header, pos);
+        entry.offset = extract<std::uint64_t>(header, pos);
+        entries.push_back(entry);
+      }
+      return descriptor;
+    }
+
+    template<class ct>
+    static Grid* createGrid (const EquidistantCoordinates<ct,dim>*, const Descriptor& descriptor, Communication comm)
+    {
+      Dune::FieldVector<ctype,dim> upperright;
+      for (int i=0; i<dim; i++)
+      {
+        if (descriptor.coords[i].front() != 0.0)
+          DUNE_THROW(GridError, "YaspCheckpoint: the grid does not start at the origin");
+        upperright[i] = descriptor.coords[i].back();
+      }
+      return new Grid(upperright, descriptor.coarseSize, descriptor.periodic, descriptor.overlap, comm);
+    }
+
+    template<class ct>
+    static Grid* createGrid (const EquidistantOffsetCoordinates<ct,dim>*, const Descriptor& descriptor, Communication comm)
+    {
+      Dune::FieldVector<ctype,dim> lowerleft, upperright;
+      for (int i=0; i<dim; i++)
+      {
+        lowerleft[i] = descriptor.coords[i].front();
+        upperright[i] = descriptor.coords[i].back();
+      }
+      return new Grid(lowerleft, upperright, descriptor.coarseSize, descriptor.periodic, descriptor.overlap, comm);
+    }
+
+    template<class ct>
+    static Grid* createGrid (const TensorProductCoordinates<ct,dim>*, const Descriptor& descriptor, Communication comm)
+    {
+      std::array<std::vector<ctype>, dim> coords;
+      for (int i=0; i<dim; i++)
+        coords[i].assign(descriptor.coords[i].begin(), descriptor.coords[i].end());
+      return new Grid(coords, descriptor.periodic, descriptor.overlap, comm);
+    }
+
+    std::string _filename;
+    std::vector<Array> _arrays;
+  };
+
+} // namespace Dune
+
+#endif // DUNE_GRID_YASPGRID_CHECKPOINT_HH
@@ -40,6 +40,46 @@ namespace Dune
       using iTupel = std::array<int, d>;
       virtual ~Partitioning() = default;
       virtual void partition(const iTupel&, int, iTupel&, int) const = 0;
+
+      /** \brief Whether processes sharing a node should be placed in a contiguous block of the torus
+       *
+       *  If true, the torus groups the processes by shared-memory node and calls partitionNodes()
+       *  instead of partition(). Otherwise processes are placed lexicographically by rank.
+       */
+      virtual bool nodeAware () const
+      {
+        return false;
+      }
+
+      /** \brief Whether the torus may let MPI_Cart_create reorder the processes if no
+       *         node-aware placement is possible
+       */
+      virtual bool reorder () const
+      {
+        return false;
+      }
+
+      /** \brief Distribute a structured grid first across nodes and then across the processes of each node
+       *
+       * The torus dimensions are the product of nodeDims and localDims in each direction.
+       * The default implementation applies partition() on both levels.
+       *
+       * \param [in] size Number of elements in each coordinate direction, for the entire grid
+       * \param [in] nodes Number of nodes
+       * \param [in] ranksPerNode Number of processors on each node
+       * \param [out] nodeDims Arrangement of the nodes
+       * \param [out] localDims Arrangement of the processors within one node
+       */
+      virtual void partitionNodes (const iTupel& size, int nodes, int ranksPerNode,
+                                   iTupel& nodeDims, iTupel& localDims, int overlap) const
+      {
+        partition(size, nodes, nodeDims, overlap);
+
+        iTupel nodeSize;
+        for (int i=0; i<d; i++)
+          nodeSize[i] = size[i] / nodeDims[i];
+        partition(nodeSize, ranksPerNode, localDims, overlap);
+      }
     };
 
     template<int d>
@@ -117,6 +157,42 @@ namespace Dune
       }
     };
 
+    /** \brief Default partitioning applied first across shared-memory nodes and then within each node
+     *
+     *  Processes on the same node are placed in a contiguous block of the torus, such that most
+     *  of the halo traffic stays on the node. This requires all nodes to host the same number
+     *  of processes. Otherwise the processes are placed by rank, or by MPI_Cart_create with
+     *  reordering if requested.
+     *
+     *  The processes are renumbered by this placement: YaspGrid::comm() is a reordered copy of
+     *  the communicator passed to the grid, and a process may have a different rank in it.
+     */
+    template<int d>
+    class NodeAwarePartitioning : public DefaultPartitioning<d>
+    {
+    public:
+      /** \brief Constructor
+       *
+       *  \param reorder let MPI_Cart_create reorder the processes if node-aware placement is not possible
+       */
+      NodeAwarePartitioning (bool reorder = false)
+        : _reorder(reorder)
+      {}
+
+      bool nodeAware () const final
+      {
+        return true;
+      }
+
+      bool reorder () const final
+      {
+        return _reorder;
+      }
+
+    private:
+      bool _reorder;
+    };
+
     /** \brief Implement yaspgrid load balance strategy for P=x^{dim} processors
      */
     template<int d>
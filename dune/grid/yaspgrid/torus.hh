@@ -5,11 +5,14 @@
 #ifndef DUNE_GRID_YASPGRID_TORUS_HH
 #define DUNE_GRID_YASPGRID_TORUS_HH
 
+#include <algorithm>
 #include <array>
 #include <bitset>
 #include <cmath>
+#include <cstring>
 #include <deque>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 #if HAVE_MPI
@@ -41,6 +44,14 @@ namespace Dune
 
      - Provide means to partition a grid to the torus.
 
+     - Optionally place processes sharing a node in a contiguous block of the torus (see
+     Yasp::NodeAwarePartitioning). In this case the torus works on a reordered copy of the
+     given communicator, so ranks returned by the torus refer to comm() of the torus. YaspGrid::comm()
+     returns this reordered communicator as well.
+
+     - Optionally exchange messages with processes on the same node through MPI-3 shared
+     memory windows instead of point-to-point messages (see sharedMemory()).
+
    */
   template<class Communication, int d>
   class Torus {
@@ -62,6 +73,102 @@ namespace Dune
       void *buffer;  // buffer to send / receive
     };
 
+#if HAVE_MPI
+    /* Shared memory windows of the processes on one node. The segment of each process starts
+     * with two counters per process q on the node: ready[q], the number of batches of messages
+     * this process has written for q, and consumed[q], the number of batches from q it has read.
+     * The current batch follows: the number of messages (-1 if all of them go point-to-point),
+     * destination, size and offset of each message (offset -1 if it goes point-to-point), and
+     * the message data. Processes only wait for the counters of the processes they exchange
+     * messages with.
+     */
+    struct SharedMemory {
+      using Word = long long;
+
+      MPI_Comm nodecomm = MPI_COMM_NULL;
+      MPI_Win win = MPI_WIN_NULL;
+      std::size_t capacity = 0;      // size of the batch area of each segment in bytes
+      std::size_t need = 0;          // size of the largest batch written by this process
+      std::vector<int> noderank;     // torus rank -> rank in nodecomm, -1 if not on this node
+      std::vector<char*> segment;    // rank in nodecomm -> its segment
+      std::vector<Word> sent;        // rank in nodecomm -> batches written for it
+      std::vector<Word> received;    // rank in nodecomm -> batches read from it
+      std::vector<int> pending;      // ranks in nodecomm that may still read my last batch
+
+      ~SharedMemory ()
+      {
+        int finalized;
+        MPI_Finalized(&finalized);
+        if (finalized)
+          return;
+        release();
+        if (nodecomm != MPI_COMM_NULL)
+          MPI_Comm_free(&nodecomm);
+      }
+
+      void release ()
+      {
+        if (win != MPI_WIN_NULL)
+        {
+          MPI_Win_unlock_all(win);
+          MPI_Win_free(&win);
+        }
+        capacity = 0;
+      }
+
+      //! counter i of the segment of q: ready[p] is counter p, consumed[p] is counter n+p
+      volatile Word& counter (int q, std::size_t i) const
+      {
+        return reinterpret_cast<volatile Word*>(segment[q])[i];
+      }
+
+      //! the batch area of the segment of q
+      char* batch (int q) const
+      {
+        return segment[q] + 2*segment.size()*sizeof(Word);
+      }
+
+      //! wait until counter i of the segment of q has reached the given value
+      void wait (int q, std::size_t i, Word value) const
+      {
+        while (counter(q, i) < value)
+          MPI_Win_sync(win);
+        MPI_Win_sync(win);
+      }
+
+      // (re)allocate the windows and reset all counters, collective on the node
+      void allocate (std::size_t bytes)
+      {
+        release();
+
+        const std::size_t n = segment.size();
+        bytes = std::max(bytes, sizeof(Word));
+        MPI_Info info;
+        MPI_Info_create(&info);
+        MPI_Info_set(info, "alloc_shared_noncontig", "true");
+        char* base;
+        MPI_Win_allocate_shared(2*n*sizeof(Word) + bytes, 1, info, nodecomm, &base, &win);
+        MPI_Info_free(&info);
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, win);
+        capacity = bytes;
+
+        for (std::size_t q=0; q<n; q++)
+        {
+          MPI_Aint size;
+          int unit;
+          MPI_Win_shared_query(win, q, &size, &unit, &segment[q]);
+        }
+
+        std::fill(reinterpret_cast<Word*>(base), reinterpret_cast<Word*>(base) + 2*n, Word(0));
+        sent.assign(n, 0);
+        received.assign(n, 0);
+        pending.clear();
+        MPI_Win_sync(win);
+        MPI_Barrier(nodecomm);
+      }
+    };
+#endif
+
   public:
     //! constructor making uninitialized object
     Torus ()
@@ -71,8 +178,14 @@ namespace Dune
     Torus (Communication comm, int tag, iTupel size, int overlap, const Yasp::Partitioning<d>* partitioner)
       : _comm(comm), _tag(tag)
     {
-      // determine dimensions
-      partitioner->partition(size, _comm.size(), _dims, overlap);
+      // determine dimensions, possibly reordering the processes
+      bool placed = false;
+#if HAVE_MPI
+      if (partitioner->nodeAware() && _comm.size() > 1)
+        placed = placeNodeAware(size, overlap, partitioner);
+#endif
+      if (!placed)
+        partitioner->partition(size, _comm.size(), _dims, overlap);
 
       // compute increments for lexicographic ordering
       int inc = 1;
@@ -383,59 +496,221 @@ namespace Dune
         _localrecvrequests.push_back(task);
     }
 
-    //! exchange messages stored in request buffers; clear request buffers afterwards
-    void exchange () const
+    /** \brief Exchange messages with processes on the same node through shared memory windows
+     *
+     *  If enabled, exchange() copies messages to processes on the same node into a shared
+     *  memory window of the sender, from which the receiver copies them. Sender and receiver
+     *  synchronize through counters in the windows, without involving other processes.
+     *  Messages that do not fit into the window of the sender go point-to-point.
+     *
+     *  The call is collective. Calling it again with enable=true keeps the windows, but grows
+     *  them to the largest set of messages any process on the node has sent so far (at least
+     *  to capacity), so that these messages go through shared memory from then on.
+     *
+     *  \param enable    whether to use shared memory windows
+     *  \param capacity  size of the window of each process in bytes
+     */
+    void sharedMemory (bool enable, std::size_t capacity = std::size_t(1) << 20)
     {
-      // handle local requests first
-      if (_localsendrequests.size()!=_localrecvrequests.size())
+#if HAVE_MPI
+      if (enable && _shm)
       {
-        std::cout << "[" << rank() << "]: ERROR: local sends/receives do not match in exchange!" << std::endl;
+        unsigned long long need = std::max(_shm->need, capacity), maxneed = 0;
+        MPI_Allreduce(&need, &maxneed, 1, MPI_UNSIGNED_LONG_LONG, MPI_MAX, _shm->nodecomm);
+        if (maxneed > _shm->capacity)
+          _shm->allocate(maxneed);
         return;
       }
-      for (unsigned int i=0; i<_localsendrequests.size(); i++)
+
+      _shm.reset();
+      if (!enable)
+        return;
+
+      auto shm = std::make_shared<SharedMemory>();
+      MPI_Comm_split_type(_comm, MPI_COMM_TYPE_SHARED, _comm.rank(), MPI_INFO_NULL, &shm->nodecomm);
+
+      int nodesize;
+      MPI_Comm_size(shm->nodecomm, &nodesize);
+      std::vector<int> members(nodesize);
+      int me = _comm.rank();
+      MPI_Allgather(&me, 1, MPI_INT, members.data(), 1, MPI_INT, shm->nodecomm);
+
+      shm->noderank.assign(_comm.size(), -1);
+      for (int q=0; q<nodesize; q++)
+        shm->noderank[members[q]] = q;
+      shm->segment.resize(nodesize, nullptr);
+      shm->allocate(capacity);
+
+      _shm = shm;
+#endif
+    }
+
+    //! return true if messages to processes on the same node go through shared memory
+    bool sharedMemory () const
+    {
+#if HAVE_MPI
+      return bool(_shm);
+#else
+      return false;
+#endif
+    }
+
+    /** \brief Persistent MPI requests for a recurring exchange
+     *
+     *  Passing the same object to exchange() repeatedly reuses the persistent requests created
+     *  by MPI_Send_init/MPI_Recv_init as long as the messages (partner, buffer and size) are the
+     *  same as in the previous exchange with this object. Otherwise the requests are recreated.
+     *  Copies do not share the requests.
+     */
+    class PersistentRequests {
+    public:
+      PersistentRequests () = default;
+
+      PersistentRequests (const PersistentRequests&)
+      {}
+
+      PersistentRequests& operator= (const PersistentRequests& other)
       {
-        if (_localsendrequests[i].size!=_localrecvrequests[i].size)
-        {
-          std::cout << "[" << rank() << "]: ERROR: size in local sends/receive does not match in exchange!" << std::endl;
-          return;
-        }
-        memcpy(_localrecvrequests[i].buffer,_localsendrequests[i].buffer,_localsendrequests[i].size);
+        if (this != &other)
+          release();
+        return *this;
       }
-      _localsendrequests.clear();
-      _localrecvrequests.clear();
+
+      ~PersistentRequests ()
+      {
+        release();
+      }
+
+    private:
+      friend class Torus;
+
+      void release ()
+      {
+#if HAVE_MPI
+        int finalized;
+        MPI_Finalized(&finalized);
+        if (!finalized)
+          for (MPI_Request& request : requests)
+            if (request != MPI_REQUEST_NULL)
+              MPI_Request_free(&request);
+        requests.clear();
+#endif
+        sends.clear();
+        recvs.clear();
+      }
+
+      std::vector<CommTask> sends;
+      std::vector<CommTask> recvs;
+#if HAVE_MPI
+      std::vector<MPI_Request> requests;
+#endif
+    };
+
+    //! exchange messages stored in request buffers; clear request buffers afterwards
+    void exchange () const
+    {
+      // handle local requests first
+      if (!exchangeLocal())
+        return;
 
 #if HAVE_MPI
       // handle foreign requests
 
-      std::vector<MPI_Request> requests(_sendrequests.size() + _recvrequests.size());
-      MPI_Request* req = requests.data();
+      std::vector<MPI_Request> requests;
+      requests.reserve(_sendrequests.size() + _recvrequests.size());
 
       // issue sends to foreign processes
       for (unsigned int i=0; i<_sendrequests.size(); i++)
-        if (_sendrequests[i].rank!=rank())
+        if (_sendrequests[i].rank!=rank() && !onNode(_sendrequests[i].rank))
         {
           //          std::cout << "[" << rank() << "]" << " send " << _sendrequests[i].size << " bytes "
           //                    << "to " << _sendrequests[i].rank << " p=" << _sendrequests[i].buffer << std::endl;
+          requests.emplace_back();
           MPI_Isend(_sendrequests[i].buffer, _sendrequests[i].size, MPI_BYTE,
-                    _sendrequests[i].rank, _tag, _comm, req++);
+                    _sendrequests[i].rank, _tag, _comm, &requests.back());
         }
 
       // issue receives from foreign processes
       for (unsigned int i=0; i<_recvrequests.size(); i++)
-        if (_recvrequests[i].rank!=rank())
+        if (_recvrequests[i].rank!=rank() && !onNode(_recvrequests[i].rank))
         {
           //          std::cout << "[" << rank() << "]"  << " recv " << _recvrequests[i].size << " bytes "
           //                    << "fm " << _recvrequests[i].rank << " p=" << _recvrequests[i].buffer << std::endl;
+          requests.emplace_back();
           MPI_Irecv(_recvrequests[i].buffer, _recvrequests[i].size, MPI_BYTE,
-                    _recvrequests[i].rank, _tag, _comm, req++);
+                    _recvrequests[i].rank, _tag, _comm, &requests.back());
         }
 
+      // messages to processes on the same node go through shared memory meanwhile
+      std::deque<std::vector<char> > discarded;
+      int mismatch = -1;
+      if (_shm)
+        mismatch = exchangeShared(requests, discarded);
+
       // Wait for communication to complete
       MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
 
       // clear request buffers
       _sendrequests.clear();
       _recvrequests.clear();
+
+      // report a mismatch only now, so that the other processes complete the exchange
+      if (mismatch >= 0)
+        DUNE_THROW(Dune::Exception, "[" << rank() << "]: shared memory message from " << mismatch << " does not match receive");
+#endif
+    }
+
+    /** \brief exchange messages stored in request buffers using persistent requests; clear request buffers afterwards
+     *
+     *  Messages to processes on the same node still go through shared memory if enabled.
+     */
+    void exchange (PersistentRequests& persistent) const
+    {
+#if HAVE_MPI
+      if (_shm)
+      {
+        exchange();
+        return;
+      }
+
+      // handle local requests first
+      if (!exchangeLocal())
+        return;
+
+      // recreate the requests if the messages changed since the last exchange
+      auto same = [](const std::vector<CommTask>& a, const std::vector<CommTask>& b) {
+        if (a.size() != b.size())
+          return false;
+        for (std::size_t i=0; i<a.size(); i++)
+          if (a[i].rank != b[i].rank || a[i].size != b[i].size || a[i].buffer != b[i].buffer)
+            return false;
+        return true;
+      };
+      if (!same(persistent.sends, _sendrequests) || !same(persistent.recvs, _recvrequests))
+      {
+        persistent.release();
+        persistent.sends = _sendrequests;
+        persistent.recvs = _recvrequests;
+        persistent.requests.resize(_sendrequests.size() + _recvrequests.size(), MPI_REQUEST_NULL);
+        MPI_Request* req = persistent.requests.data();
+
+        for (const CommTask& task : _sendrequests)
+          MPI_Send_init(task.buffer, task.size, MPI_BYTE, task.rank, _tag, _comm, req++);
+        for (const CommTask& task : _recvrequests)
+          MPI_Recv_init(task.buffer, task.size, MPI_BYTE, task.rank, _tag, _comm, req++);
+      }
+
+      if (!persistent.requests.empty())
+      {
+        MPI_Startall(persistent.requests.size(), persistent.requests.data());
+        MPI_Waitall(persistent.requests.size(), persistent.requests.data(), MPI_STATUSES_IGNORE);
+      }
+
+      // clear request buffers
+      _sendrequests.clear();
+      _recvrequests.clear();
+#else
+      exchange();
 #endif
     }
 
@@ -469,6 +744,270 @@ namespace Dune
 
   private:
 
+    //! copy messages to this process; returns false if sends and receives do not match
+    bool exchangeLocal () const
+    {
+      if (_localsendrequests.size()!=_localrecvrequests.size())
+      {
+        std::cout << "[" << rank() << "]: ERROR: local sends/receives do not match in exchange!" << std::endl;
+        return false;
+      }
+      for (unsigned int i=0; i<_localsendrequests.size(); i++)
+      {
+        if (_localsendrequests[i].size!=_localrecvrequests[i].size)
+        {
+          std::cout << "[" << rank() << "]: ERROR: size in local sends/receive does not match in exchange!" << std::endl;
+          return false;
+        }
+        memcpy(_localrecvrequests[i].buffer,_localsendrequests[i].buffer,_localsendrequests[i].size);
+      }
+      _localsendrequests.clear();
+      _localrecvrequests.clear();
+      return true;
+    }
+
+#if HAVE_MPI
+    //! return true if messages to the given rank go through shared memory
+    bool onNode (int rank) const
+    {
+      return _shm && _shm->noderank[rank] >= 0;
+    }
+
+    /** \brief exchange the messages to and from processes on the same node through the shared memory windows
+     *
+     *  Messages that go point-to-point are started and their requests appended to requests.
+     *  Returns -1, or the rank of a process whose messages did not match the receives; these
+     *  are received into discarded.
+     */
+    int exchangeShared (std::vector<MPI_Request>& requests, std::deque<std::vector<char> >& discarded) const
+    {
+      using Word = typename SharedMemory::Word;
+      auto aligned = [](std::size_t bytes) { return (bytes + sizeof(Word) - 1) / sizeof(Word) * sizeof(Word); };
+
+      SharedMemory& shm = *_shm;
+      const int me = shm.noderank[rank()];
+      const std::size_t n = shm.segment.size();
+
+      // my last batch may only be overwritten once its receivers have read it
+      for (int q : shm.pending)
+        shm.wait(q, n + me, shm.sent[q]);
+      shm.pending.clear();
+
+      // write my batch: header with count, destinations, sizes and offsets, then the messages
+      std::size_t count = 0;
+      std::size_t bytes = 0;
+      for (const CommTask& task : _sendrequests)
+        if (onNode(task.rank))
+        {
+          count++;
+          bytes += aligned(task.size);
+        }
+      if (count > 0)
+      {
+        std::size_t used = (1 + 3*count) * sizeof(Word);
+        shm.need = std::max(shm.need, used + bytes);
+        const bool fits = (used <= shm.capacity);
+
+        Word* header = reinterpret_cast<Word*>(shm.batch(me));
+        header[0] = fits ? Word(count) : Word(-1);
+        std::size_t k = 0;
+        for (const CommTask& task : _sendrequests)
+          if (onNode(task.rank))
+          {
+            const std::size_t size = aligned(task.size);
+            const bool inlined = fits && (used + size <= shm.capacity);
+            if (fits)
+            {
+              header[1+3*k] = task.rank;
+              header[2+3*k] = task.size;
+              header[3+3*k] = inlined ? Word(used) : Word(-1);
+            }
+            if (inlined)
+            {
+              std::memcpy(shm.batch(me) + used, task.buffer, task.size);
+              used += size;
+            }
+            else
+            {
+              requests.emplace_back();
+              MPI_Isend(task.buffer, task.size, MPI_BYTE, task.rank, _tag, _comm, &requests.back());
+            }
+            k++;
+          }
+
+        // announce the batch to each of its receivers
+        MPI_Win_sync(shm.win);
+        for (const CommTask& task : _sendrequests)
+          if (onNode(task.rank))
+          {
+            const int q = shm.noderank[task.rank];
+            if (std::find(shm.pending.begin(), shm.pending.end(), q) != shm.pending.end())
+              continue;
+            shm.counter(me, q) = ++shm.sent[q];
+            shm.pending.push_back(q);
+          }
+        MPI_Win_sync(shm.win);
+      }
+
+      // read the batch of each sender, matching its messages to me with my receives in order
+      int mismatch = -1;
+      std::vector<int> sources;
+      for (const CommTask& task : _recvrequests)
+        if (onNode(task.rank) && std::find(sources.begin(), sources.end(), task.rank) == sources.end())
+          sources.push_back(task.rank);
+      for (int source : sources)
+      {
+        const int q = shm.noderank[source];
+        shm.wait(q, me, shm.received[q] + 1);
+
+        const Word* header = reinterpret_cast<const Word*>(shm.batch(q));
+        const Word messages = header[0];
+        Word entry = 0;
+        auto discard = [&](Word size) {
+          mismatch = source;
+          discarded.emplace_back(size);
+          requests.emplace_back();
+          MPI_Irecv(discarded.back().data(), size, MPI_BYTE, source, _tag, _comm, &requests.back());
+        };
+        for (const CommTask& task : _recvrequests)
+        {
+          if (task.rank != source)
+            continue;
+          if (messages < 0)
+          {
+            requests.emplace_back();
+            MPI_Irecv(task.buffer, task.size, MPI_BYTE, source, _tag, _comm, &requests.back());
+            continue;
+          }
+
+          while (entry < messages && header[1+3*entry] != rank())
+            entry++;
+          if (entry == messages)
+          {
+            mismatch = source;
+            continue;
+          }
+          const Word size = header[2+3*entry];
+          const Word offset = header[3+3*entry];
+          entry++;
+
+          if (size != task.size)
+          {
+            if (offset < 0)
+              discard(size);
+            mismatch = source;
+          }
+          else if (offset < 0)
+          {
+            requests.emplace_back();
+            MPI_Irecv(task.buffer, task.size, MPI_BYTE, source, _tag, _comm, &requests.back());
+          }
+          else
+            std::memcpy(task.buffer, shm.batch(q) + offset, task.size);
+        }
+
+        // messages to me without a matching receive
+        for (; entry < messages; entry++)
+          if (header[1+3*entry] == rank())
+          {
+            mismatch = source;
+            if (header[3+3*entry] < 0)
+              discard(header[2+3*entry]);
+          }
+
+        // confirm that the batch has been read
+        MPI_Win_sync(shm.win);
+        shm.counter(me, n + q) = ++shm.received[q];
+        MPI_Win_sync(shm.win);
+      }
+
+      return mismatch;
+    }
+
+    /** \brief Group the processes by shared-memory node and reorder the communicator accordingly
+     *
+     *  Each node gets a block of localDims processes in the torus; the blocks are arranged as nodeDims.
+     *  The communicator of the torus is replaced by one whose lexicographic rank ordering matches
+     *  this placement. Returns false if the nodes host different numbers of processes and no
+     *  reordering by MPI_Cart_create was requested.
+     */
+    bool placeNodeAware (const iTupel& size, int overlap, const Yasp::Partitioning<d>* partitioner)
+    {
+      MPI_Comm comm = _comm;
+
+      // find the processes on my node and number the nodes by their first process
+      MPI_Comm nodecomm;
+      MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, _comm.rank(), MPI_INFO_NULL, &nodecomm);
+      int localrank, localsize;
+      MPI_Comm_rank(nodecomm, &localrank);
+      MPI_Comm_size(nodecomm, &localsize);
+
+      MPI_Comm leadercomm;
+      MPI_Comm_split(comm, (localrank == 0) ? 0 : MPI_UNDEFINED, _comm.rank(), &leadercomm);
+      int node = 0;
+      if (localrank == 0)
+      {
+        MPI_Comm_rank(leadercomm, &node);
+        MPI_Comm_free(&leadercomm);
+      }
+      MPI_Bcast(&node, 1, MPI_INT, 0, nodecomm);
+      MPI_Comm_free(&nodecomm);
+
+      int minsize = _comm.min(localsize);
+      int maxsize = _comm.max(localsize);
+
+      MPI_Comm newcomm;
+      if (minsize == maxsize && maxsize < _comm.size())
+      {
+        int nodes = _comm.size() / localsize;
+        iTupel nodeDims, localDims;
+        partitioner->partitionNodes(size, nodes, localsize, nodeDims, localDims, overlap);
+
+        // coordinate of this process: block of the node plus position within the block
+        int key = 0;
+        int inc = 1;
+        for (int i=0; i<d; i++)
+        {
+          int nodecoord = node % nodeDims[i];
+          int localcoord = localrank % localDims[i];
+          node /= nodeDims[i];
+          localrank /= localDims[i];
+
+          _dims[i] = nodeDims[i] * localDims[i];
+          key += (nodecoord * localDims[i] + localcoord) * inc;
+          inc *= _dims[i];
+        }
+        MPI_Comm_split(comm, 0, key, &newcomm);
+      }
+      else if (partitioner->reorder())
+      {
+        partitioner->partition(size, _comm.size(), _dims, overlap);
+
+        // MPI_Cart_create numbers row-major, the torus numbers with the first direction running fastest
+        std::array<int, d> cartdims, periods;
+        for (int i=0; i<d; i++)
+        {
+          cartdims[i] = _dims[d-1-i];
+          periods[i] = 0;
+        }
+        MPI_Cart_create(comm, d, cartdims.data(), periods.data(), 1, &newcomm);
+      }
+      else
+        return false;
+
+      // the torus owns the new communicator
+      _ownedComm = std::shared_ptr<MPI_Comm>(new MPI_Comm(newcomm), [](MPI_Comm* c) {
+          int finalized;
+          MPI_Finalized(&finalized);
+          if (!finalized)
+            MPI_Comm_free(c);
+          delete c;
+        });
+      _comm = Communication(newcomm);
+      return true;
+    }
+#endif
+
     void proclists ()
     {
       // compile the full neighbor list
@@ -522,6 +1061,10 @@ namespace Dune
     }
 
     Communication _comm;
+#if HAVE_MPI
+    std::shared_ptr<MPI_Comm> _ownedComm;
+    std::shared_ptr<SharedMemory> _shm;
+#endif
 
     iTupel _dims;
     iTupel _increment;
@@ -226,12 +226,12 @@ namespace Dune {
       return _origin[i] + size(i) - 1;
     }
 
-    //! Return true if YGrid is empty, i.e. has size 0 in all directions.
+    //! Return true if YGrid is empty, i.e. has size 0 in some direction.
     bool empty () const
     {
       for (int i=0; i<d; ++i)
       {
-        if (size(i) == 0)
+        if (size(i) <= 0)
           return true;
       }
       return false;
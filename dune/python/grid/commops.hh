@@ -9,7 +9,7 @@ namespace Dune
   {
     namespace detail
     {
-      enum CommOp { add=0, set=1 };
+      enum CommOp { add=0, set=1, min=2, max=3 };
     }
   }
 }
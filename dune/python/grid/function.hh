@@ -15,6 +15,7 @@
 #include <dune/common/visibility.hh>
 
 #include <dune/python/common/dimrange.hh>
+#include <dune/python/common/getdimension.hh>
 #include <dune/python/common/typeregistry.hh>
 #include <dune/python/common/vector.hh>
 #include <dune/python/common/fvector.hh>
@@ -107,6 +108,47 @@ namespace Dune
         dataWithPartition(Dune::Partitions::interiorBorderOverlap);
         dataWithPartition(Dune::Partitions::interiorBorderOverlapFront);
 
+        typedef pybind11::array_t< typename FieldTraits< typename GridFunctionTraits< GridFunction >::LocalCoordinate >::field_type > Points;
+        typedef typename FieldTraits< Range >::field_type RangeField;
+        cls.def( "evaluateBatch", [] ( const GridFunction &self, pybind11::array_t< int > elementIndices, Points localPoints ) {
+            return evaluateBatch( self, elementIndices, localPoints );
+          }, "elementIndices"_a, "localPoints"_a,
+          R"doc(
+            Evaluate the function at one local point in each of a list of elements.
+
+            Args:
+                elementIndices: indices of the elements in an element mapper,
+                                i.e., the index set index for grids with a single element type
+                localPoints:    array of shape (len(elementIndices), dim) with the local coordinates
+
+            Returns: array of shape (len(elementIndices), dimRange) with the values.
+                     Each element is bound only once, independent of the order of the indices.
+          )doc" );
+        cls.def( "evaluateBatch", [] ( const GridFunction &self, pybind11::array_t< int > elementIndices, Points localPoints,
+                                       pybind11::array_t< RangeField, pybind11::array::c_style > out ) {
+            if( (out.ndim() != 2) || (std::size_t( out.shape( 0 ) ) != std::size_t( elementIndices.size() ))
+                || (out.shape( 1 ) != GetDimension< Range >::value) )
+              throw pybind11::value_error( "'out' must have shape (len(elementIndices), dimRange)." );
+            evaluateBatch( self, elementIndices, localPoints, out.mutable_data() );
+          }, "elementIndices"_a, "localPoints"_a, "out"_a.noconvert(),
+          R"doc(
+            Evaluate the function at one local point in each of a list of elements
+            and write the values into the preallocated array `out`.
+          )doc" );
+        cls.def( "evaluateAtQuadrature", [] ( const GridFunction &self, int order ) { return evaluateAtQuadrature( self, order ); },
+          "order"_a,
+          R"doc(
+            Evaluate the function at the quadrature points of all elements.
+
+            Args:
+                order: order of the quadrature rules
+
+            Returns: (offsets,weights,values) where the quadrature points of the element
+                     with index i in an element mapper are offsets[i]:offsets[i+1], weights
+                     contains the quadrature weights multiplied by the integration element,
+                     and values has shape (offsets[-1], dimRange).
+          )doc" );
+
         cls.def( "polygonData", [] ( const GridFunction &self ) { return polygonData( self ); },
           R"doc(
             Store the grid with piecewise constant data in numpy arrays.
@@ -425,6 +425,23 @@ namespace Dune
                    the format `[ [x_1,y_1], [x_2,y_2], ..., [x_N,y_N] ]` for example
                    in 2d (will be filled up by zeros if dimworld is larger
                    than the world dimension of the view.
+                   The vertices are ordered by their index in the index set.
+        )doc" );
+      cls.def( "connectivity", [] ( const GridView &self, int codim, bool csr ) { return connectivity( self, codim, csr ); },
+        "codim"_a = 0, pybind11::kw_only(), "csr"_a = false,
+        R"doc(
+          Vertex indices of all entities of a codimension, matching the order of `coordinates`.
+
+          Args:
+              codim: codimension of the entities (default: elements)
+              csr:   return a compressed row structure, needed if the entities
+                     have different numbers of vertices
+
+          Returns: `numpy` array of shape (size(codim), nVertices) with the vertex
+                   indices of each entity in reference element numbering, or the tuple
+                   (offsets,indices) if `csr` is set, where the vertices of entity i
+                   are `indices[offsets[i]:offsets[i+1]]`. Entities are ordered by
+                   their index in the index set.
         )doc" );
       cls.def( "tessellate", [] ( const GridView &self, int level, int dimworld) { return tessellate( self, level, dimworld ); },
         "level"_a = 0, pybind11::kw_only(), "dimworld"_a=GridView::dimensionworld,
@@ -6,12 +6,15 @@
 #define DUNE_PYTHON_GRID_HIERARCHICAL_HH
 
 #include <array>
+#include <cstdint>
 #include <functional>
 #include <list>
 #include <map>
 #include <memory>
 #include <sstream>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 #include <dune/common/hybridutilities.hh>
 #include <dune/common/iteratorrange.hh>
@@ -43,6 +46,14 @@
 namespace Dune
 {
 
+  // External Forward Declarations
+  // -----------------------------
+
+  template< int dim, int dimworld >
+  class AlbertaGrid;
+
+
+
   namespace Python
   {
 
@@ -140,6 +151,237 @@ namespace Dune
         } ) );
     }
 
+    namespace detail
+    {
+
+      // HasBinaryPickling
+      // -----------------
+
+      // unstructured grids are pickled through their grid factory; grids with a stream based
+      // backup / restore facility keep using it
+      template< class Grid >
+      struct HasBinaryPickling
+        : public std::integral_constant< bool, Capabilities::HasGridFactory< Grid >::value && !Capabilities::hasBackupRestoreFacilities< Grid >::v >
+      {};
+
+      template< int dim, int dimworld >
+      struct HasBinaryPickling< AlbertaGrid< dim, dimworld > >
+        : public std::true_type
+      {};
+
+
+
+      // forEachHierarchicElement
+      // ------------------------
+
+      // visit all elements of a level in a canonical order: macro elements in the given order,
+      // their descendants in the order of the hierarchic iterator
+      template< class Grid, class Seeds, class F >
+      inline static void forEachHierarchicElement ( const Grid &grid, const Seeds &macros, int level, F &&f )
+      {
+        for( const auto &seed : macros )
+        {
+          const auto macro = grid.entity( seed );
+          if( level == 0 )
+            f( macro );
+          else
+          {
+            const auto end = macro.hend( level );
+            for( auto it = macro.hbegin( level ); it != end; ++it )
+              if( it->level() == level )
+                f( *it );
+          }
+        }
+      }
+
+
+
+      // binaryBackup
+      // ------------
+
+      /* The state consists of NumPy arrays describing the macro grid (vertex coordinates,
+       * element types and connectivity, boundary segments ordered by their index) and the
+       * refinement flags of all non-leaf elements, level by level. Pickle protocol 5 can
+       * hand these arrays out of band, i.e., without copying them into the pickle stream.
+       */
+      template< class Grid >
+      inline static pybind11::tuple binaryBackup ( const Grid &grid )
+      {
+        const int dim = Grid::dimension;
+        const int dimworld = Grid::dimensionworld;
+        typedef typename Grid::ctype ctype;
+
+        if( grid.comm().size() > 1 )
+          throw pybind11::value_error( "Pickling of distributed grids is not supported." );
+
+        const auto gridView = grid.levelGridView( 0 );
+        const auto &indexSet = gridView.indexSet();
+
+        const std::size_t numVertices = indexSet.size( dim );
+        pybind11::array_t< ctype > coordinates( { numVertices, static_cast< std::size_t >( dimworld ) } );
+        auto x = coordinates.template mutable_unchecked< 2 >();
+        for( const auto &vertex : vertices( gridView ) )
+        {
+          const auto i = indexSet.index( vertex );
+          const auto center = vertex.geometry().center();
+          for( int k = 0; k < dimworld; ++k )
+            x( i, k ) = center[ k ];
+        }
+
+        std::vector< typename Grid::template Codim< 0 >::EntitySeed > macros;
+        std::vector< unsigned int > types, offsets( 1, 0u ), connectivity;
+        std::vector< std::vector< unsigned int > > segments( grid.numBoundarySegments() );
+        macros.reserve( indexSet.size( 0 ) );
+        types.reserve( indexSet.size( 0 ) );
+        offsets.reserve( indexSet.size( 0 )+1 );
+        for( const auto &element : elements( gridView ) )
+        {
+          macros.push_back( element.seed() );
+          types.push_back( element.type().id() );
+          const auto refElement = referenceElement< ctype, dim >( element.type() );
+          for( int i = 0; i < refElement.size( dim ); ++i )
+            connectivity.push_back( indexSet.subIndex( element, i, dim ) );
+          offsets.push_back( static_cast< unsigned int >( connectivity.size() ) );
+
+          for( const auto &intersection : intersections( gridView, element ) )
+          {
+            if( !intersection.boundary() )
+              continue;
+            const int face = intersection.indexInInside();
+            auto &segment = segments[ intersection.boundarySegmentIndex() ];
+            segment.clear();
+            for( int i = 0; i < refElement.size( face, 1, dim ); ++i )
+              segment.push_back( indexSet.subIndex( element, refElement.subEntity( face, 1, i, dim ), dim ) );
+          }
+        }
+
+        std::vector< unsigned int > segmentOffsets( 1, 0u ), segmentVertices;
+        segmentOffsets.reserve( segments.size()+1 );
+        for( const auto &segment : segments )
+        {
+          segmentVertices.insert( segmentVertices.end(), segment.begin(), segment.end() );
+          segmentOffsets.push_back( static_cast< unsigned int >( segmentVertices.size() ) );
+        }
+
+        std::vector< unsigned int > levelOffsets( 1, 0u );
+        std::vector< std::uint8_t > refined;
+        for( int level = 0; level < grid.maxLevel(); ++level )
+        {
+          forEachHierarchicElement( grid, macros, level, [ &refined ] ( const auto &element ) {
+              refined.push_back( element.isLeaf() ? 0 : 1 );
+            } );
+          levelOffsets.push_back( static_cast< unsigned int >( refined.size() ) );
+        }
+
+        auto asArray = [] ( const auto &v ) {
+            typedef typename std::decay_t< decltype( v ) >::value_type T;
+            return pybind11::array_t< T >( v.size(), v.data() );
+          };
+        return pybind11::make_tuple( "binary", 1, dim, std::move( coordinates ),
+                                     asArray( types ), asArray( offsets ), asArray( connectivity ),
+                                     asArray( segmentOffsets ), asArray( segmentVertices ),
+                                     asArray( levelOffsets ), asArray( refined ) );
+      }
+
+
+
+      // binaryRestore
+      // -------------
+
+      template< class Grid >
+      inline static std::shared_ptr< Grid > binaryRestore ( const pybind11::tuple &state )
+      {
+        const int dim = Grid::dimension;
+        const int dimworld = Grid::dimensionworld;
+        typedef typename Grid::ctype ctype;
+
+        if( (state.size() != 11) || (state[ 0 ].cast< std::string >() != "binary") || (state[ 1 ].cast< int >() != 1) )
+          throw std::runtime_error( "Invalid state in HGrid::setstate" );
+        if( state[ 2 ].cast< int >() != dim )
+          throw pybind11::value_error( "Pickled grid has dimension " + std::to_string( state[ 2 ].cast< int >() ) + ", expected " + std::to_string( dim ) + "." );
+
+        typedef pybind11::array_t< unsigned int, pybind11::array::c_style | pybind11::array::forcecast > IndexArray;
+        const auto coordinates = state[ 3 ].cast< pybind11::array_t< ctype, pybind11::array::c_style | pybind11::array::forcecast > >();
+        const auto types = state[ 4 ].cast< IndexArray >();
+        const auto offsets = state[ 5 ].cast< IndexArray >();
+        const auto connectivity = state[ 6 ].cast< IndexArray >();
+        const auto segmentOffsets = state[ 7 ].cast< IndexArray >();
+        const auto segmentVertices = state[ 8 ].cast< IndexArray >();
+        const auto levelOffsets = state[ 9 ].cast< IndexArray >();
+        const auto refined = state[ 10 ].cast< pybind11::array_t< std::uint8_t, pybind11::array::c_style | pybind11::array::forcecast > >();
+
+        if( (coordinates.ndim() != 2) || (coordinates.shape( 1 ) != dimworld) )
+          throw pybind11::value_error( "Pickled grid has invalid vertex coordinates." );
+
+        GridFactory< Grid > factory;
+        const auto x = coordinates.template unchecked< 2 >();
+        for( pybind11::ssize_t i = 0; i < x.shape( 0 ); ++i )
+        {
+          FieldVector< ctype, dimworld > position;
+          for( int k = 0; k < dimworld; ++k )
+            position[ k ] = x( i, k );
+          factory.insertVertex( position );
+        }
+
+        const unsigned int *o = offsets.data();
+        const unsigned int *c = connectivity.data();
+        for( pybind11::ssize_t i = 0; i < types.size(); ++i )
+          factory.insertElement( GeometryType( types.data()[ i ], dim ), std::vector< unsigned int >( c + o[ i ], c + o[ i+1 ] ) );
+
+        const unsigned int *so = segmentOffsets.data();
+        const unsigned int *sv = segmentVertices.data();
+        for( pybind11::ssize_t i = 0; i+1 < segmentOffsets.size(); ++i )
+          factory.insertBoundarySegment( std::vector< unsigned int >( sv + so[ i ], sv + so[ i+1 ] ) );
+
+        std::shared_ptr< Grid > grid( factory.createGrid() );
+
+        // restore the order of the macro elements used for the refinement flags
+        std::vector< typename Grid::template Codim< 0 >::EntitySeed > macros( types.size() );
+        const auto gridView = grid->levelGridView( 0 );
+        try
+        {
+          for( const auto &element : elements( gridView ) )
+            macros[ factory.insertionIndex( element ) ] = element.seed();
+        }
+        catch( const NotImplemented & )
+        {
+          // without insertion indices, rely on the grid reproducing the macro element order
+          macros.clear();
+          for( const auto &element : elements( gridView ) )
+            macros.push_back( element.seed() );
+        }
+
+        const unsigned int *lo = levelOffsets.data();
+        const std::uint8_t *r = refined.data();
+        for( pybind11::ssize_t level = 0; level+1 < levelOffsets.size(); ++level )
+        {
+          unsigned int i = lo[ level ];
+          forEachHierarchicElement( *grid, macros, level, [ &grid, &i, r ] ( const auto &element ) {
+              if( r[ i++ ] )
+                grid->mark( 1, element );
+            } );
+          if( i != lo[ level+1 ] )
+            throw std::runtime_error( "Unable to restore the refinement hierarchy of pickled grid." );
+          grid->preAdapt();
+          grid->adapt();
+          grid->postAdapt();
+        }
+        return grid;
+      }
+
+    } // namespace detail
+
+    template< class Grid, class... options >
+    inline static std::enable_if_t< detail::HasBinaryPickling< Grid >::value >
+    registerHierarchicalGridPicklingSupport ( pybind11::class_< Grid, options... > cls, PriorityTag< 2 > )
+    {
+      cls.def( pybind11::pickle( [] ( const Grid &grid ) { // __getstate__
+          return detail::binaryBackup( grid );
+        }, [] ( pybind11::tuple t ) { // __setstate__
+          return detail::binaryRestore< Grid >( t );
+        } ) );
+    }
+
     template< class Grid, class... options >
     inline static void
     registerHierarchicalGridPicklingSupport ( pybind11::class_< Grid, options... > cls, PriorityTag< 0 > )
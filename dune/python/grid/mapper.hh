@@ -5,6 +5,7 @@
 #ifndef DUNE_PYTHON_GRID_MAPPER_HH
 #define DUNE_PYTHON_GRID_MAPPER_HH
 
+#include <algorithm>
 #include <functional>
 
 #include <dune/common/visibility.hh>
@@ -114,6 +115,15 @@ namespace Dune
         registerMapperSubIndex< Entity >( cls, PriorityTag< 42 >() );
       }
 
+      template< class Mapper, class Function >
+      void mapperCommunicate ( const Mapper &mapper, Function function,
+                               std::vector< pybind11::array_t< double > > data,
+                               InterfaceType iftype, CommunicationDirection dir )
+      {
+        auto dataHandle = numPyCommDataHandle( mapper, std::move( data ), std::move( function ) );
+        mapper.gridView().communicate( dataHandle, iftype, dir );
+      }
+
       template <class Mapper>
       void mapperCommunicate(const Mapper &mapper, CommOp commOp,
                              std::vector<pybind11::array_t<double>> data,
@@ -122,17 +132,13 @@ namespace Dune
         switch (commOp)
         {
         case add:
-          {
-          auto dataHandle = numPyCommDataHandle( mapper, data,
-              [] (double local, double remote) {return remote+local;});
-          mapper.gridView().communicate( dataHandle, iftype, dir );
-          }
+          return mapperCommunicate( mapper, [] ( double local, double remote ) { return local + remote; }, std::move( data ), iftype, dir );
         case set:
-          {
-          auto dataHandle = numPyCommDataHandle( mapper, data,
-              [] (double local, double remote) {return remote;});
-          mapper.gridView().communicate( dataHandle, iftype, dir );
-          }
+          return mapperCommunicate( mapper, [] ( double local, double remote ) { return remote; }, std::move( data ), iftype, dir );
+        case min:
+          return mapperCommunicate( mapper, [] ( double local, double remote ) { return std::min( local, remote ); }, std::move( data ), iftype, dir );
+        case max:
+          return mapperCommunicate( mapper, [] ( double local, double remote ) { return std::max( local, remote ); }, std::move( data ), iftype, dir );
         }
       }
 
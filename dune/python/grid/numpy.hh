@@ -9,11 +9,15 @@
 #include <algorithm>
 #include <array>
 #include <map>
+#include <numeric>
+#include <string>
 #include <vector>
 
 #include <dune/common/ftraits.hh>
+#include <dune/common/hybridutilities.hh>
 
 #include <dune/geometry/dimension.hh>
+#include <dune/geometry/quadraturerules.hh>
 #include <dune/geometry/type.hh>
 #include <dune/geometry/virtualrefinement.hh>
 #include <dune/geometry/referenceelements.hh>
@@ -78,6 +82,82 @@ namespace Dune
       return coordinates( gridView, mapper, dimworld );
     }
 
+    // connectivity
+    // ------------
+
+    template< class GridView, int codim >
+    inline static pybind11::object connectivity ( const GridView &gridView, Dune::Codim< codim >, bool csr )
+    {
+      typedef typename GridView::ctype ctype;
+
+      const int dim = GridView::dimension;
+      const int mydim = dim - codim;
+
+      const auto &indexSet = gridView.indexSet();
+      MultipleCodimMultipleGeomTypeMapper< GridView > vertexMapper( gridView, mcmgVertexLayout() );
+      MultipleCodimMultipleGeomTypeMapper< GridView > mapper( gridView, mcmgLayout( Dune::Codim< codim >() ) );
+      const std::size_t size = mapper.size();
+
+      // the mapper numbers the geometry types consecutively in the order of indexSet.types
+      std::vector< std::size_t > offsets( 1, 0 );
+      offsets.reserve( size+1 );
+      std::size_t width = 0;
+      bool uniform = true;
+      for( const GeometryType &type : indexSet.types( codim ) )
+      {
+        const std::size_t corners = ReferenceElements< ctype, mydim >::general( type ).size( mydim );
+        uniform &= (width == 0) || (width == corners);
+        width = corners;
+        for( std::size_t i = 0; i < indexSet.size( type ); ++i )
+          offsets.push_back( offsets.back() + corners );
+      }
+      if( !csr && !uniform )
+        throw pybind11::value_error( "Entities of codimension " + std::to_string( codim ) + " have different numbers of vertices, use 'csr=True'." );
+
+      pybind11::array_t< int > indices( offsets.back() );
+      int *out = static_cast< int * >( indices.request( true ).ptr );
+
+      // fill the vertex indices of each entity when first seen as subentity of an element
+      std::vector< bool > visited( size, false );
+      for( const auto &element : elements( gridView, Partitions::all ) )
+      {
+        const auto refElement = referenceElement< ctype, dim >( element.type() );
+        for( int i = 0; i < refElement.size( codim ); ++i )
+        {
+          const std::size_t index = mapper.subIndex( element, i, codim );
+          if( visited[ index ] )
+            continue;
+          visited[ index ] = true;
+          int *row = out + offsets[ index ];
+          for( int j = 0; j < refElement.size( i, codim, dim ); ++j )
+            row[ j ] = vertexMapper.subIndex( element, refElement.subEntity( i, codim, j, dim ), dim );
+        }
+      }
+
+      if( csr )
+      {
+        pybind11::array_t< int > rows( offsets.size() );
+        std::copy( offsets.begin(), offsets.end(), static_cast< int * >( rows.request( true ).ptr ) );
+        return pybind11::make_tuple( rows, indices );
+      }
+      return indices.reshape( { size, width } );
+    }
+
+    template< class GridView >
+    inline static pybind11::object connectivity ( const GridView &gridView, int codim, bool csr = false )
+    {
+      pybind11::object result;
+      Hybrid::forEach( std::make_integer_sequence< int, GridView::dimension+1 >(), [ &gridView, codim, csr, &result ] ( auto cd ) {
+          if( cd == codim )
+            result = connectivity( gridView, Dune::Codim< decltype( cd )::value >(), csr );
+        } );
+      if( !result )
+        throw pybind11::value_error( "Invalid codimension: " + std::to_string( codim ) );
+      return result;
+    }
+
+
+
     // flatCopy
     // --------
 
@@ -133,37 +213,45 @@ namespace Dune
       typedef typename GridView::ctype ctype;
 
       const std::size_t dimGrid = GridView::dimension;
+      dimworld = std::max( dimworld, std::size_t( GridView::dimensionworld ) );
+
+      // count points and simplices to fill the arrays directly
+      std::size_t nPoints = 0, nSimplices = 0;
+      for( const auto &element : elements( gridView, ps ) )
+      {
+        const auto &refinement = buildRefinement< dimGrid, double >( element.type(), GeometryTypes::simplex( dimGrid ) );
+        nPoints += refinement.nVertices( intervals );
+        nSimplices += refinement.nElements( intervals );
+      }
+
+      pybind11::array_t< ctype > coords( { nPoints, dimworld } );
+      pybind11::array_t< int > simplices( { nSimplices, dimGrid+1 } );
+      ctype *x = static_cast< ctype * >( coords.request( true ).ptr );
+      int *s = static_cast< int * >( simplices.request( true ).ptr );
 
-      std::vector< std::vector< ctype > > coords;
-      std::vector< std::array< int, dimGrid+1 > > simplices;
+      std::size_t offset = 0;
       for( const auto &element : elements( gridView, ps ) )
       {
         const auto &refinement = buildRefinement< dimGrid, double >( element.type(), GeometryTypes::simplex( dimGrid ) );
-        const std::size_t offset = coords.size();
 
         // get coordinates
         const auto geometry = element.geometry();
         for( auto it = refinement.vBegin( intervals ), end = refinement.vEnd( intervals ); it != end; ++it )
         {
-          auto point = geometry.global( it.coords() );
-          coords.push_back( std::vector<ctype>(std::max((int)dimworld,GridView::dimensionworld), 0) );
-          std::copy(point.begin(),point.end(), coords[coords.size()-1].begin());
+          const auto point = geometry.global( it.coords() );
+          x = std::fill_n( std::copy( point.begin(), point.end(), x ), dimworld - GridView::dimensionworld, ctype( 0 ) );
         }
 
         // get simplices
         for( auto it = refinement.eBegin( intervals ), end = refinement.eEnd( intervals ); it != end; ++it )
         {
-          std::array< int, dimGrid+1 > simplex;
           auto indices = it.vertexIndices();
-          assert( indices.size() == simplex.size() );
-          std::transform( indices.begin(), indices.end(), simplex.begin(), [ offset ] ( std::size_t i ) { return (i + offset); } );
-          simplices.push_back( simplex );
+          assert( indices.size() == dimGrid+1 );
+          s = std::transform( indices.begin(), indices.end(), s, [ offset ] ( std::size_t i ) { return (i + offset); } );
         }
+        offset += refinement.nVertices( intervals );
       }
-      return std::make_pair(
-             makeNumPyArray< ctype >( coords, { coords.size(), dimworld } ),
-             makeNumPyArray< int >( simplices, { simplices.size(), dimGrid+1 } ) );
-
+      return std::make_pair( coords, simplices );
     }
 
     template< class GridView, unsigned int partitions >
@@ -377,6 +465,139 @@ namespace Dune
     }
 
 
+    // evaluateBatch
+    // -------------
+
+    template< class GridFunction >
+    inline static void evaluateBatch ( const GridFunction &gridFunction,
+                                       pybind11::array_t< int > elementIndices,
+                                       pybind11::array_t< typename FieldTraits< typename GridFunctionTraits< GridFunction >::LocalCoordinate >::field_type > localPoints,
+                                       typename FieldTraits< typename GridFunctionTraits< GridFunction >::Range >::field_type *out )
+    {
+      typedef typename GridFunctionTraits< GridFunction >::GridView GridView;
+      typedef typename GridFunctionTraits< GridFunction >::Element Element;
+      typedef typename GridFunctionTraits< GridFunction >::LocalCoordinate LocalCoordinate;
+      typedef typename GridFunctionTraits< GridFunction >::Range Range;
+
+      const std::size_t dimRange = GetDimension< Range >::value;
+
+      auto indices = elementIndices.template unchecked< 1 >();
+      auto points = localPoints.template unchecked< 2 >();
+      const std::size_t size = indices.shape( 0 );
+      if( (std::size_t( points.shape( 0 ) ) != size) || (points.shape( 1 ) != LocalCoordinate::dimension) )
+        throw pybind11::value_error( "'localPoints' must have shape (len(elementIndices), " + std::to_string( LocalCoordinate::dimension ) + ")." );
+
+      const auto &gv = gridView( gridFunction );
+      MultipleCodimMultipleGeomTypeMapper< GridView > mapper( gv, mcmgElementLayout() );
+
+      // sort the requests by element, so that each element is bound once
+      std::vector< std::size_t > offsets( mapper.size()+1, 0 );
+      for( std::size_t i = 0; i < size; ++i )
+      {
+        if( (indices( i ) < 0) || (std::size_t( indices( i ) ) >= mapper.size()) )
+          throw pybind11::index_error( "Invalid element index: " + std::to_string( indices( i ) ) );
+        ++offsets[ indices( i )+1 ];
+      }
+      std::partial_sum( offsets.begin(), offsets.end(), offsets.begin() );
+      std::vector< std::size_t > requests( size );
+      std::vector< std::size_t > next( offsets.begin(), offsets.end()-1 );
+      for( std::size_t i = 0; i < size; ++i )
+        requests[ next[ indices( i ) ]++ ] = i;
+
+      auto lf = localFunction( gridFunction );
+      for( const Element &element : elements( gv, Partitions::all ) )
+      {
+        const auto index = mapper.index( element );
+        if( offsets[ index ] == offsets[ index+1 ] )
+          continue;
+
+        lf.bind( element );
+        for( std::size_t k = offsets[ index ]; k < offsets[ index+1 ]; ++k )
+        {
+          const std::size_t i = requests[ k ];
+          LocalCoordinate x;
+          for( int j = 0; j < LocalCoordinate::dimension; ++j )
+            x[ j ] = points( i, j );
+          flatCopy( lf( x ), out + i*dimRange );
+        }
+        lf.unbind();
+      }
+    }
+
+    template< class GridFunction >
+    inline static auto evaluateBatch ( const GridFunction &gridFunction,
+                                       pybind11::array_t< int > elementIndices,
+                                       pybind11::array_t< typename FieldTraits< typename GridFunctionTraits< GridFunction >::LocalCoordinate >::field_type > localPoints )
+    {
+      typedef typename GridFunctionTraits< GridFunction >::Range Range;
+      typedef typename FieldTraits< Range >::field_type RangeField;
+
+      const std::size_t size = elementIndices.size();
+      const std::size_t dimRange = GetDimension< Range >::value;
+      pybind11::array_t< RangeField > values( { size, dimRange } );
+      evaluateBatch( gridFunction, elementIndices, localPoints, static_cast< RangeField * >( values.request( true ).ptr ) );
+      return values;
+    }
+
+
+
+    // evaluateAtQuadrature
+    // --------------------
+
+    template< class GridFunction >
+    inline static auto evaluateAtQuadrature ( const GridFunction &gridFunction, int order )
+    {
+      typedef typename GridFunctionTraits< GridFunction >::GridView GridView;
+      typedef typename GridFunctionTraits< GridFunction >::Element Element;
+      typedef typename GridFunctionTraits< GridFunction >::LocalCoordinate LocalCoordinate;
+      typedef typename GridFunctionTraits< GridFunction >::Range Range;
+
+      typedef typename FieldTraits< LocalCoordinate >::field_type ctype;
+      typedef typename FieldTraits< Range >::field_type RangeField;
+
+      const int mydim = Element::mydimension;
+      const std::size_t dimRange = GetDimension< Range >::value;
+
+      const auto &gv = gridView( gridFunction );
+      const auto &indexSet = gv.indexSet();
+      MultipleCodimMultipleGeomTypeMapper< GridView > mapper( gv, mcmgElementLayout() );
+
+      // the mapper numbers the geometry types consecutively in the order of indexSet.types
+      std::vector< std::size_t > offsets( 1, 0 );
+      offsets.reserve( mapper.size()+1 );
+      for( const GeometryType &type : indexSet.types( 0 ) )
+      {
+        const std::size_t points = QuadratureRules< ctype, mydim >::rule( type, order ).size();
+        for( std::size_t i = 0; i < indexSet.size( type ); ++i )
+          offsets.push_back( offsets.back() + points );
+      }
+
+      pybind11::array_t< int > rows( offsets.size() );
+      std::copy( offsets.begin(), offsets.end(), static_cast< int * >( rows.request( true ).ptr ) );
+      pybind11::array_t< ctype > weights( offsets.back() );
+      pybind11::array_t< RangeField > values( { offsets.back(), dimRange } );
+      ctype *w = static_cast< ctype * >( weights.request( true ).ptr );
+      RangeField *v = static_cast< RangeField * >( values.request( true ).ptr );
+
+      auto lf = localFunction( gridFunction );
+      for( const Element &element : elements( gv, Partitions::all ) )
+      {
+        const auto geometry = element.geometry();
+        std::size_t k = offsets[ mapper.index( element ) ];
+        lf.bind( element );
+        for( const auto &qp : QuadratureRules< ctype, mydim >::rule( element.type(), order ) )
+        {
+          w[ k ] = qp.weight() * geometry.integrationElement( qp.position() );
+          flatCopy( lf( qp.position() ), v + k*dimRange );
+          ++k;
+        }
+        lf.unbind();
+      }
+
+      return std::make_tuple( rows, weights, values );
+    }
+
+
     // deprecated tesselate (note spelling) functions
     template< class GridView, unsigned int partitions >
     [[deprecated("use 'tessellate' (note spelling)")]]
@@ -7,8 +7,11 @@
 #include <cstddef>
 
 #include <algorithm>
+#include <functional>
+#include <numeric>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <dune/common/visibility.hh>
 
@@ -48,15 +51,28 @@ namespace Dune
 
     public:
       NumPyCommDataHandle ( const Mapper &mapper, std::vector< pybind11::array_t< T > > arrays, Function function = Function() )
-        : mapper_( mapper ), buffers_( arrays.size() ), function_( function )
+        : mapper_( mapper ), buffers_( arrays.size() ), rowSizes_( arrays.size(), 0 ), function_( function )
       {
         std::transform( arrays.begin(), arrays.end(), buffers_.begin(), [] ( pybind11::array_t< T > &a ) { return a.request(); } );
         itemSize_ = 0;
-        for( const pybind11::buffer_info &buffer : buffers_ )
+        for( std::size_t i = 0; i < buffers_.size(); ++i )
         {
+          const pybind11::buffer_info &buffer = buffers_[ i ];
           if( static_cast< std::size_t >( buffer.shape[ 0 ] ) != mapper_.size() )
-            pybind11::value_error( "Array does not match mapper in construction of NumPyCommDataHandle." );
-          itemSize_ += std::accumulate( buffer.shape.begin()+1, buffer.shape.end(), std::size_t( 1 ), std::multiplies< std::size_t >() );
+            throw pybind11::value_error( "Array does not match mapper in construction of NumPyCommDataHandle." );
+          const std::size_t rowSize = std::accumulate( buffer.shape.begin()+1, buffer.shape.end(), std::size_t( 1 ), std::multiplies< std::size_t >() );
+          itemSize_ += rowSize;
+
+          // rows stored contiguously are read and written directly instead of walking the strides
+          ssize_t stride = sizeof( T );
+          bool contiguous = true;
+          for( ssize_t d = buffer.ndim-1; d > 0; --d )
+          {
+            contiguous &= (buffer.strides[ d ] == stride);
+            stride *= buffer.shape[ d ];
+          }
+          if( contiguous )
+            rowSizes_[ i ] = rowSize;
         }
       }
 
@@ -85,18 +101,46 @@ namespace Dune
       template< class CommBuffer, class Entity >
       void gather ( CommBuffer &commBuffer, const Entity &entity ) const
       {
-        for( const pybind11::buffer_info &buffer : buffers_ )
+        for( std::size_t i = 0; i < buffers_.size(); ++i )
+        {
+          const pybind11::buffer_info &buffer = buffers_[ i ];
           for( const auto index : mapper_.indices( entity ) )
-            gather( commBuffer, buffer, 1, index*buffer.strides[ 0 ] );
+          {
+            if( rowSizes_[ i ] > 0 )
+            {
+              const T *row = reinterpret_cast< const T * >( static_cast< const char * >( buffer.ptr ) + index*buffer.strides[ 0 ] );
+              for( std::size_t k = 0; k < rowSizes_[ i ]; ++k )
+                commBuffer.write( row[ k ] );
+            }
+            else
+              gather( commBuffer, buffer, 1, index*buffer.strides[ 0 ] );
+          }
+        }
       }
 
       template< class CommBuffer, class Entity >
       void scatter ( CommBuffer &commBuffer, const Entity &entity, std::size_t n )
       {
         assert( n == size( entity ) );
-        for( const pybind11::buffer_info &buffer : buffers_ )
+        for( std::size_t i = 0; i < buffers_.size(); ++i )
+        {
+          const pybind11::buffer_info &buffer = buffers_[ i ];
           for( const auto index : mapper_.indices( entity ) )
-            scatter( commBuffer, buffer, 1, index*buffer.strides[ 0 ] );
+          {
+            if( rowSizes_[ i ] > 0 )
+            {
+              T *row = reinterpret_cast< T * >( static_cast< char * >( buffer.ptr ) + index*buffer.strides[ 0 ] );
+              for( std::size_t k = 0; k < rowSizes_[ i ]; ++k )
+              {
+                T remote;
+                commBuffer.read( remote );
+                row[ k ] = function_( row[ k ], remote );
+              }
+            }
+            else
+              scatter( commBuffer, buffer, 1, index*buffer.strides[ 0 ] );
+          }
+        }
       }
 
     private:
@@ -131,6 +175,7 @@ namespace Dune
 
       const Mapper &mapper_;
       std::vector< pybind11::buffer_info > buffers_;
+      std::vector< std::size_t > rowSizes_;
       std::size_t itemSize_;
       Function function_;
     };
@@ -0,0 +1,60 @@
+# SPDX-FileCopyrightText: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+# SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+import numpy
+from dune.grid import structuredGrid, CommOp, PartitionType
+
+def weight(x):
+    return 1 + x[0] + 2*x[1]
+
+def test_commops(gridView):
+    rank = gridView.comm.rank
+    mapper = gridView.mapper(lambda gt: gt.dim == 0)
+    ib = gridView.interiorBorderPartition
+
+    g = numpy.zeros(len(mapper))
+    border = numpy.zeros(len(mapper), dtype=bool)
+    for vertex in gridView.vertices:
+        i = mapper.index(vertex)
+        g[i] = weight(vertex.geometry.center)
+        border[i] = vertex.partitionType == PartitionType.Border
+    local = (rank+1)*g
+
+    # number of processes sharing each vertex
+    count = numpy.ones(len(mapper))
+    mapper.communicate(ib, ib, CommOp.add, count)
+
+    added, lower, upper = local.copy(), local.copy(), local.copy()
+    mapper.communicate(ib, ib, CommOp.add, added)
+    mapper.communicate(ib, ib, CommOp.min, lower)
+    mapper.communicate(ib, ib, CommOp.max, upper)
+
+    # vertices not on the process border are left untouched
+    inner = ~border
+    assert numpy.all(count[inner] == 1)
+    for data in (added, lower, upper):
+        assert numpy.array_equal(data[inner], local[inner])
+
+    # on the border each copy sees the reduction over all processes sharing the vertex
+    if numpy.any(border):
+        assert numpy.all(count[border] >= 2)
+        assert numpy.all(lower[border] < upper[border])
+        assert numpy.all(lower[border] <= local[border])
+        assert numpy.all(local[border] <= upper[border])
+        assert numpy.all(added[border] >= lower[border] + upper[border] - 1e-10)
+        pair = border & (count == 2)
+        assert numpy.allclose(added[pair], lower[pair] + upper[pair])
+        # all copies carry (rank+1)*g, so the reductions are integer multiples of g
+        for data in (added, lower, upper):
+            assert numpy.allclose(data[border] / g[border], numpy.round(data[border] / g[border]))
+
+    # each column of a 2d array (contiguous or not) is reduced independently
+    for order in ('C', 'F'):
+        both = numpy.array(numpy.column_stack((local, -local)), order=order)
+        mapper.communicate(ib, ib, CommOp.min, both)
+        assert numpy.allclose(both[:, 0], lower)
+        assert numpy.allclose(both[:, 1], -upper)
+
+if __name__ == "__main__":
+    grid = structuredGrid([0, 0], [1, 1], [8, 8])
+    test_commops(grid)
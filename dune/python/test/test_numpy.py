@@ -0,0 +1,63 @@
+# SPDX-FileCopyrightText: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+# SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+import numpy
+from dune.grid import gridFunction, structuredGrid
+
+def test_connectivity(gridView):
+    indexSet = gridView.indexSet
+    dim = gridView.dimension
+    coords = gridView.coordinates()
+    assert coords.shape == (gridView.size(dim), gridView.dimWorld)
+    for vertex in gridView.vertices:
+        assert numpy.allclose(coords[indexSet.index(vertex)], vertex.geometry.center)
+
+    for codim in range(dim+1):
+        cells = gridView.connectivity(codim)
+        assert cells.shape[0] == gridView.size(codim)
+        offsets, indices = gridView.connectivity(codim, csr=True)
+        assert len(offsets) == gridView.size(codim)+1
+        assert numpy.array_equal(indices.reshape(cells.shape), cells)
+
+    cells = gridView.connectivity()
+    for element in gridView.elements:
+        assert list(cells[indexSet.index(element)]) == list(indexSet.subIndices(element, dim))
+
+def test_tessellate(gridView):
+    points, simplices = gridView.tessellate(1)
+    assert points.shape[1] == gridView.dimWorld
+    assert simplices.shape[1] == gridView.dimension+1
+    assert simplices.max() < points.shape[0]
+    points, simplices = gridView.tessellate(dimworld=3)
+    assert points.shape[1] == 3
+    assert numpy.all(points[:,2] == 0)
+
+def test_evaluate(gridView):
+    @gridFunction(gridView)
+    def f(x):
+        return [x[0]*x[1], x[0]+x[1]]
+
+    indexSet = gridView.indexSet
+    elements = list(gridView.elements)
+    indices = numpy.array([indexSet.index(e) for e in elements][::-1] * 2)
+    points = numpy.random.rand(len(indices), gridView.dimension)
+    values = f.evaluateBatch(indices, points)
+    assert values.shape == (len(indices), 2)
+    byIndex = {indexSet.index(e): e for e in elements}
+    for i, x, y in zip(indices, points, values):
+        assert numpy.allclose(f(byIndex[i], x), y)
+
+    out = numpy.zeros(values.shape)
+    f.evaluateBatch(indices, points, out)
+    assert numpy.array_equal(out, values)
+
+    offsets, weights, values = f.evaluateAtQuadrature(2)
+    assert len(offsets) == gridView.size(0)+1
+    assert abs(weights.sum() - 1) < 1e-12
+    assert abs(numpy.dot(weights, values[:,0]) - 0.25) < 1e-12
+
+if __name__ == "__main__":
+    gridView = structuredGrid([0,0],[1,1],[4,3])
+    test_connectivity(gridView)
+    test_tessellate(gridView)
+    test_evaluate(gridView)
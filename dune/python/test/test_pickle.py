@@ -0,0 +1,32 @@
+# SPDX-FileCopyrightText: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+# SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+import pickle, numpy
+from dune.grid import Marker, onedGrid
+
+def compare(grid, other):
+    hgrid, ohgrid = grid.hierarchicalGrid, other.hierarchicalGrid
+    assert hgrid.maxLevel == ohgrid.maxLevel
+    for level in range(hgrid.maxLevel+1):
+        assert hgrid.levelView(level).size(0) == ohgrid.levelView(level).size(0)
+    assert numpy.allclose(numpy.sort(grid.coordinates(), axis=0), numpy.sort(other.coordinates(), axis=0))
+
+if __name__ == "__main__":
+    vertices = numpy.array([[0.0], [0.2], [0.3], [0.7], [1.0]])
+    grid = onedGrid({"vertices": vertices, "simplices": [[0, 1], [1, 2], [2, 3], [3, 4]]})
+
+    # refine locally towards the left boundary
+    hgrid = grid.hierarchicalGrid
+    for _ in range(3):
+        hgrid.adapt(lambda e: Marker.refine if e.geometry.center[0] < 0.25 else Marker.keep)
+
+    for protocol in range(2, pickle.HIGHEST_PROTOCOL+1):
+        other = pickle.loads(pickle.dumps(hgrid, protocol=protocol))
+        compare(grid, other.leafView)
+
+    # out-of-band transfer of the state arrays
+    if pickle.HIGHEST_PROTOCOL >= 5:
+        buffers = []
+        data = pickle.dumps(hgrid, protocol=5, buffer_callback=buffers.append)
+        other = pickle.loads(data, buffers=buffers)
+        compare(grid, other.leafView)
@@ -0,0 +1,14 @@
+# SPDX-FileCopyrightText: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+# SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+
+from dune.grid import structuredGrid
+from dune.grid.grid_generator import prebuild
+
+if __name__ == "__main__":
+    assert prebuild(("Yasp",), (2,)) == []
+    # unsupported dimensions are skipped instead of failing
+    assert prebuild(("OneD",), (2,)) == []
+
+    # the prebuilt modules are picked up afterwards
+    grid = structuredGrid([0, 0], [1, 1], [2, 2])
+    assert grid.size(0) == 4
@@ -1,18 +1,37 @@
 # SPDX-FileCopyrightText: Copyright © DUNE Project contributors, see file LICENSE.md in module root
 # SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
 
-import os
+import argparse, os
 
-path = os.path.join( os.path.dirname(__file__), "tutorial" )
-execute  = "cp -RL " + path + " "
-execute += "grid_tutorial"
-status = os.system(execute)
-if status != 0: raise RuntimeError(status)
+parser = argparse.ArgumentParser(prog="python -m dune.grid",
+    description="Copy the grid tutorial or compile grid modules ahead of time.")
+subparsers = parser.add_subparsers(dest="command")
+subparsers.add_parser("tutorial", help="copy the tutorial into the folder 'grid_tutorial' (default)")
+prebuildParser = subparsers.add_parser("prebuild", help="compile the modules for the given grid configurations")
+prebuildParser.add_argument("--grids", nargs="+", default=["Yasp"],
+    help="grid types from dune.grid.grid_registry (default: Yasp)")
+prebuildParser.add_argument("--dimensions", nargs="+", type=int, default=[1,2,3],
+    help="grid dimensions (default: 1 2 3)")
+prebuildParser.add_argument("--dimRanges", nargs="+", type=int, default=[0,1],
+    help="ranges of the grid functions, 0 for scalar functions (default: 0 1)")
+args = parser.parse_args()
 
-print("##################################################################")
-print("## An example script is now located in the 'grid_tutorial' folder.")
-try:
-    import matplotlib
-except ImportError:
-    print("## Note: the examples requires the installation of 'matplotlib'.")
-print("##################################################################")
+if args.command == "prebuild":
+    from dune.grid.grid_generator import prebuild
+    failed = prebuild(args.grids, args.dimensions, args.dimRanges)
+    if failed:
+        raise SystemExit("prebuild failed for: " + ", ".join(name + " (dimension " + str(dim) + ")" for name, dim, _ in failed))
+else:
+    path = os.path.join( os.path.dirname(__file__), "tutorial" )
+    execute  = "cp -RL " + path + " "
+    execute += "grid_tutorial"
+    status = os.system(execute)
+    if status != 0: raise RuntimeError(status)
+
+    print("##################################################################")
+    print("## An example script is now located in the 'grid_tutorial' folder.")
+    try:
+        import matplotlib
+    except ImportError:
+        print("## Note: the examples requires the installation of 'matplotlib'.")
+    print("##################################################################")
@@ -70,6 +70,8 @@ PYBIND11_MODULE( _grid, module )
   pybind11::enum_< Dune::Python::detail::CommOp > commOps( module, "CommOp" );
   commOps.value( "set", Dune::Python::detail::CommOp::set );
   commOps.value( "add", Dune::Python::detail::CommOp::add );
+  commOps.value( "min", Dune::Python::detail::CommOp::min );
+  commOps.value( "max", Dune::Python::detail::CommOp::max );
 
   pybind11::enum_< Dune::Python::Marker > marker( module, "Marker" );
   marker.value( "coarsen", Dune::Python::Marker::Coarsen );
@@ -13,6 +13,25 @@ from dune.generator.algorithm import cppType
 from dune.generator import builder
 from dune.deprecate import deprecated
 
+# modules already loaded by this process, keyed by their (content hashed) module name;
+# repeated requests for the same type skip code generation and the module cache lookup
+_modules = {}
+def _load(generator, includes, typeName, moduleName, *args, **kwargs):
+    try:
+        return _modules[moduleName]
+    except KeyError:
+        module = generator.load(includes, typeName, moduleName, *args, **kwargs)
+        _modules[moduleName] = module
+        return module
+
+def _build(moduleName, source, signature):
+    try:
+        return _modules[moduleName]
+    except KeyError:
+        module = builder.load(moduleName, source, signature)
+        _modules[moduleName] = module
+        return module
+
 def getDimgrid(constructor):
     dimgrid = None
     if not dimgrid:
@@ -138,14 +157,14 @@ def indexSet(gv):
         includes = gv.cppIncludes + ["dune/python/grid/indexset.hh"]
         typeName = gv.cppTypeName+"::IndexSet"
         moduleName = "indexset_" + hashIt(typeName)
-        module = isGenerator.load(includes, typeName, moduleName)
+        module = _load(isGenerator, includes, typeName, moduleName)
         return gv._indexSet
 mcmgGenerator = SimpleGenerator("MultipleCodimMultipleGeomTypeMapper", "Dune::Python")
 def mapper(gv,layout):
     includes = gv.cppIncludes + ["dune/python/grid/mapper.hh"]
     typeName = "Dune::MultipleCodimMultipleGeomTypeMapper< "+gv.cppTypeName+" >"
     moduleName = "mcmgmapper_" + hashIt(typeName)
-    module = mcmgGenerator.load(includes, typeName, moduleName)
+    module = _load(mcmgGenerator, includes, typeName, moduleName)
     return gv._mapper(layout)
 
 import functools
@@ -221,7 +240,7 @@ def function(gv,callback,includeFiles=None,*args,name=None,order=None,dimRange=N
         source += ");\n"
         source += "}\n"
         source += "#endif\n"
-        gf = builder.load(moduleName, source, signature).gf(gv,*args)
+        gf = _build(moduleName, source, signature).gf(gv,*args)
     else:
         if len(inspect.signature(callback).parameters) == 1: # global function, turn into a local function
             callback_ = callback
@@ -281,7 +300,7 @@ def function(gv,callback,includeFiles=None,*args,name=None,order=None,dimRange=N
             source += "  Dune::Python::registerGridFunction< "+gv.cppTypeName+", Evaluate, "+str(dimRange)+" >( module, \"gf\", "+scalar+" );\n"
             source += "}\n"
             source += "#endif\n"
-            gfModule = builder.load(moduleName, source, signature)
+            gfModule = _build(moduleName, source, signature)
             gfFunc = getattr(gfModule,"gf"+str(dimRange))
             """
             if callback_ is not None:
@@ -349,7 +368,7 @@ gvGenerator = SimpleGenerator("GridView", "Dune::Python")
 def viewModule(includes, typeName, *args, **kwargs):
     includes = includes + ["dune/python/grid/gridview.hh"]
     moduleName = "view_" + hashIt(typeName)
-    module = gvGenerator.load(includes, typeName, moduleName, *args, **kwargs)
+    module = _load(gvGenerator, includes, typeName, moduleName, *args, **kwargs)
     return module
 
 def levelView(hgrid,level):
@@ -363,7 +382,7 @@ def persistentContainer(hgrid,codim,dimension):
     includes = hgrid.cppIncludes + ["dune/python/grid/persistentcontainer.hh"]
     typeName = "Dune::PersistentContainer<"+hgrid.cppTypeName+", Dune::FieldVector<double,"+str(dimension)+">>"
     moduleName = "persistentcontainer_" + hashIt(typeName)
-    module = pcGenerator.load(includes, typeName, moduleName)
+    module = _load(pcGenerator, includes, typeName, moduleName)
     return module.PersistentContainer(hgrid,codim)
 
 def module(includes, typeName, *args, **kwargs):
@@ -375,9 +394,55 @@ def module(includes, typeName, *args, **kwargs):
     typeHash = "hierarchicalgrid_" + hashIt(typeName)
     kwargs["dynamicAttr"] = True
     kwargs["holder"] = "std::shared_ptr"
-    module = generator.load(includes, typeName, typeHash, *args, **kwargs)
+    module = _load(generator, includes, typeName, typeHash, *args, **kwargs)
     return module
 
+# grid dimensions supported by the grid managers, all others are tried for every dimension
+_prebuildDimensions = {"OneD": (1,), "UG": (2,3)}
+
+def prebuild(grids=("Yasp",), dimensions=(1,2,3), dimRanges=(0,1)):
+    """Compile the modules for the given grid configurations ahead of time.
+
+    For each grid type from `dune.grid.grid_registry` and grid dimension this
+    builds the grid, its leaf and level views, index set, vertex mapper, and
+    Python grid functions with the given ranges, so that later runs find all
+    of them in the module cache. Run it once, serially, before starting parallel
+    jobs to avoid compiling in the job itself.
+
+    Dimensions a grid manager does not support are skipped. A configuration
+    that fails to build (e.g. an AlbertaGrid dimension not enabled at
+    configure time) is reported and does not stop the remaining ones.
+
+    Returns: list of `(grid, dimension, error)` for the failed configurations.
+    """
+    import logging
+    from dune.grid import grid_registry, cartesianDomain
+    failed = []
+    for name in grids:
+        try:
+            factory = grid_registry[name]
+        except KeyError:
+            raise ValueError("unknown grid '" + name + "', available are: " + ", ".join(grid_registry.keys()))
+        for dim in dimensions:
+            if dim not in _prebuildDimensions.get(name, (dim,)):
+                continue
+            try:
+                gv = factory(cartesianDomain([0]*dim, [1]*dim, [1]*dim))
+                if gv is None: # grid manager not available
+                    break
+                gv.indexSet
+                gv.mapper(lambda gt: gt.dim == 0)
+                gv.hierarchicalGrid.levelView(0)
+                for dimRange in dimRanges:
+                    gv.function(_zero(dimRange), dimRange=dimRange)
+            except Exception as e:
+                logging.getLogger(__name__).warning("prebuild: failed to build " + name + " grid of dimension " + str(dim) + ": " + str(e))
+                failed.append((name, dim, e))
+    return failed
+
+def _zero(dimRange):
+    return lambda x: [0]*dimRange if dimRange > 0 else 0
+
 if __name__ == "__main__":
     import doctest
     doctest.testmod(optionflags=doctest.ELLIPSIS)
@@ -0,0 +1,354 @@
+// SPDX-FileCopyrightText: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_GRID_BENCHMARKS_BENCHMARK_HH
+#define DUNE_GRID_BENCHMARKS_BENCHMARK_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+#include <dune/common/parametertree.hh>
+#include <dune/common/timer.hh>
+
+#include <dune/geometry/referenceelements.hh>
+
+#include <dune/grid/common/capabilities.hh>
+#include <dune/grid/common/datahandleif.hh>
+#include <dune/grid/common/gridenums.hh>
+#include <dune/grid/common/mcmgmapper.hh>
+#include <dune/grid/common/rangegenerators.hh>
+#include <dune/grid/io/file/gmshreader.hh>
+#include <dune/grid/io/file/gmshwriter.hh>
+#include <dune/grid/io/file/vtk/vtkwriter.hh>
+
+namespace Dune
+{
+
+  namespace Benchmark
+  {
+
+    // results of the benchmarks are accumulated here, so the compiler cannot drop the loops
+    inline volatile double sink = 0.0;
+
+
+
+    // Report
+    // ------
+
+    /** \brief Runs benchmarks and collects their timings
+     *
+     *  Each benchmark is a functor returning the number of items it processed. It is run
+     *  once to warm up and then \c repeat times; the fastest run is reported. In parallel,
+     *  the time of a run is the maximum over all processes.
+     */
+    class Report
+    {
+      struct Result
+      {
+        std::string grid, name;
+        std::size_t items, bytes;
+        double seconds;
+      };
+
+    public:
+      explicit Report ( const ParameterTree &params )
+        : repeat_( std::max( params.get( "repeat", 3 ), 1 ) ),
+          filter_( params.get< std::string >( "grids", "" ) ),
+          verbose_( params.get( "verbose", true ) )
+      {}
+
+      //! return true if the benchmarks for the given grid are requested
+      bool enabled ( const std::string &grid ) const
+      {
+        return filter_.empty() || (("," + filter_ + ",").find( "," + grid + "," ) != std::string::npos);
+      }
+
+      //! time a repeatable benchmark
+      template< class Comm, class F >
+      void run ( const Comm &comm, const std::string &grid, const std::string &name, F &&f, std::size_t bytesPerItem = 0 )
+      {
+        std::size_t items = f();
+        double seconds = std::numeric_limits< double >::max();
+        for( int r = 0; r < repeat_; ++r )
+        {
+          Timer timer;
+          items = f();
+          seconds = std::min( seconds, comm.max( timer.elapsed() ) );
+        }
+        add( comm, grid, name, items, bytesPerItem, seconds );
+      }
+
+      //! time a benchmark that changes the grid and can only be run once
+      template< class Comm, class F >
+      void runOnce ( const Comm &comm, const std::string &grid, const std::string &name, F &&f )
+      {
+        Timer timer;
+        std::size_t items = f();
+        add( comm, grid, name, items, 0, comm.max( timer.elapsed() ) );
+      }
+
+      //! write the results as JSON
+      void writeJson ( std::ostream &out, const ParameterTree &params, int processes ) const
+      {
+        out << "{\n  \"processes\": " << processes << ",\n";
+        out << "  \"cells\": " << params.get( "cells", 128 ) << ",\n";
+        out << "  \"repeat\": " << repeat_ << ",\n";
+        out << "  \"benchmarks\": [";
+        for( std::size_t i = 0; i < results_.size(); ++i )
+        {
+          const Result &result = results_[ i ];
+          out << (i > 0 ? "," : "") << "\n    { \"grid\": \"" << result.grid << "\", \"name\": \"" << result.name << "\""
+              << ", \"items\": " << result.items << ", \"bytes\": " << result.bytes
+              << ", \"seconds\": " << std::setprecision( 9 ) << result.seconds
+              << ", \"itemsPerSecond\": " << std::setprecision( 9 ) << rate( result.items, result.seconds ) << " }";
+        }
+        out << "\n  ]\n}\n";
+      }
+
+    private:
+      template< class Comm >
+      void add ( const Comm &comm, const std::string &grid, const std::string &name, std::size_t items, std::size_t bytesPerItem, double seconds )
+      {
+        results_.push_back( Result{ grid, name, items, items*bytesPerItem, seconds } );
+        if( verbose_ && (comm.rank() == 0) )
+          std::cout << std::left << std::setw( 20 ) << grid << std::setw( 24 ) << name
+                    << std::right << std::setw( 12 ) << items << " items  "
+                    << std::setw( 12 ) << std::setprecision( 4 ) << seconds << " s  "
+                    << std::setw( 12 ) << std::setprecision( 4 ) << rate( items, seconds ) << " items/s" << std::endl;
+      }
+
+      static double rate ( std::size_t items, double seconds )
+      {
+        return (seconds > 0.0 ? items / seconds : 0.0);
+      }
+
+      int repeat_;
+      std::string filter_;
+      bool verbose_;
+      std::vector< Result > results_;
+    };
+
+
+
+    // ElementDataHandle
+    // -----------------
+
+    /** \brief data handle sending a fixed number of doubles per element
+     *
+     *  The data does not depend on the entity, so the handle also works for meta grids
+     *  passing host entities to the data handle.
+     */
+    class ElementDataHandle
+      : public CommDataHandleIF< ElementDataHandle, double >
+    {
+    public:
+      explicit ElementDataHandle ( std::size_t count ) : count_( count ) {}
+
+      bool contains ( int, int codim ) const { return (codim == 0); }
+      bool fixedSize ( int, int ) const { return true; }
+
+      template< class Entity >
+      std::size_t size ( const Entity & ) const { return count_; }
+
+      template< class Buffer, class Entity >
+      void gather ( Buffer &buffer, const Entity & ) const
+      {
+        for( std::size_t i = 0; i < count_; ++i )
+          buffer.write( 1.0 );
+      }
+
+      template< class Buffer, class Entity >
+      void scatter ( Buffer &buffer, const Entity &, std::size_t n )
+      {
+        double value = 0.0;
+        for( std::size_t i = 0; i < n; ++i )
+        {
+          buffer.read( value );
+          sum_ += value;
+        }
+      }
+
+      double sum () const { return sum_; }
+
+    private:
+      std::size_t count_;
+      double sum_ = 0.0;
+    };
+
+
+
+    // benchmarkGrid
+    // -------------
+
+    /** \brief run all benchmarks on a grid
+     *
+     *  \param  report   report collecting the results
+     *  \param  name     short name of the grid used in the report and for output files
+     *  \param  grid     grid to benchmark; it is refined and load balanced at the end
+     *  \param  params   parameters (prefix for output files, size of communicated data)
+     *  \param  reader   benchmark reading the grid from a Gmsh file (needs a GridFactory)
+     */
+    template< class Grid >
+    inline void benchmarkGrid ( Report &report, const std::string &name, Grid &grid,
+                                const ParameterTree &params, bool reader = false )
+    {
+      const int dim = Grid::dimension;
+      const auto &comm = grid.comm();
+      const auto gridView = grid.leafGridView();
+      typedef std::decay_t< decltype( gridView ) > GridView;
+
+      report.run( comm, name, "elements", [ &gridView ] () {
+          std::size_t n = 0;
+          for( const auto &element : elements( gridView ) )
+            n += (element.level() >= 0);
+          return n;
+        } );
+
+      report.run( comm, name, "vertices", [ &gridView ] () {
+          std::size_t n = 0;
+          for( const auto &vertex : vertices( gridView ) )
+            n += (vertex.level() >= 0);
+          return n;
+        } );
+
+      report.run( comm, name, "intersections", [ &gridView ] () {
+          std::size_t n = 0, boundary = 0;
+          for( const auto &element : elements( gridView ) )
+            for( const auto &intersection : intersections( gridView, element ) )
+            {
+              ++n;
+              boundary += intersection.boundary();
+            }
+          sink = sink + boundary;
+          return n;
+        } );
+
+      report.run( comm, name, "geometry", [ &gridView ] () {
+          std::size_t n = 0;
+          double s = 0.0;
+          for( const auto &element : elements( gridView ) )
+          {
+            const auto geometry = element.geometry();
+            const auto local = referenceElement( geometry ).position( 0, 0 );
+            s += geometry.volume() + geometry.global( local )[ 0 ] + geometry.jacobianInverseTransposed( local )[ 0 ][ 0 ];
+            ++n;
+          }
+          sink = sink + s;
+          return n;
+        } );
+
+      report.run( comm, name, "index", [ &gridView ] () {
+          const auto &indexSet = gridView.indexSet();
+          std::size_t n = 0, s = 0;
+          for( const auto &element : elements( gridView ) )
+          {
+            s += indexSet.index( element );
+            for( unsigned int i = 0; i < element.subEntities( dim ); ++i )
+              s += indexSet.subIndex( element, i, dim );
+            ++n;
+          }
+          sink = sink + s;
+          return n;
+        } );
+
+      report.run( comm, name, "id", [ &grid, &gridView ] () {
+          const auto &idSet = grid.localIdSet();
+          typename Grid::LocalIdSet::IdType last{};
+          std::size_t n = 0, equal = 0;
+          for( const auto &element : elements( gridView ) )
+          {
+            const auto id = idSet.id( element );
+            equal += (id == last);
+            last = id;
+            ++n;
+          }
+          sink = sink + equal;
+          return n;
+        } );
+
+      MultipleCodimMultipleGeomTypeMapper< GridView > vertexMapper( gridView, mcmgVertexLayout() );
+      std::vector< double > vertexData( vertexMapper.size(), 0.0 );
+      report.run( comm, name, "mapper", [ &gridView, &vertexMapper, &vertexData ] () {
+          std::size_t n = 0;
+          for( const auto &element : elements( gridView ) )
+          {
+            for( unsigned int i = 0; i < element.subEntities( dim ); ++i )
+              vertexData[ vertexMapper.subIndex( element, i, dim ) ] += 1.0;
+            ++n;
+          }
+          return n;
+        } );
+
+      std::vector< double > elementData( gridView.size( 0 ), 1.0 );
+      if constexpr (Capabilities::canCommunicate< Grid, 0 >::v)
+      {
+        const std::size_t count = params.get( "commsize", 64 );
+        for( std::size_t size : { std::size_t( 1 ), count } )
+        {
+          report.run( comm, name, "communicate-" + std::to_string( size ), [ &gridView, size ] () {
+              ElementDataHandle handle( size );
+              gridView.communicate( handle, InteriorBorder_All_Interface, ForwardCommunication );
+              sink = sink + handle.sum();
+              return std::size_t( gridView.size( 0 ) );
+            }, size*sizeof( double ) );
+        }
+      }
+
+      const std::string prefix = params.get< std::string >( "prefix", "dune-grid-benchmark" ) + "-" + name;
+      report.run( comm, name, "vtk-write", [ &gridView, &elementData, &prefix ] () {
+          VTKWriter< GridView > vtkWriter( gridView );
+          vtkWriter.addCellData( elementData, "data" );
+          vtkWriter.write( prefix, VTK::appendedraw );
+          return std::size_t( gridView.size( 0 ) );
+        } );
+
+      if( reader && (comm.size() == 1) )
+      {
+        const std::string fileName = prefix + ".msh";
+        GmshWriter< GridView >( gridView ).write( fileName );
+        report.run( comm, name, "gmsh-read", [ &fileName ] () {
+            const auto readGrid = GmshReader< Grid >::read( fileName, false, false );
+            return std::size_t( readGrid->leafGridView().size( 0 ) );
+          } );
+      }
+
+      report.runOnce( comm, name, "globalRefine", [ &grid ] () {
+          grid.globalRefine( 1 );
+          return std::size_t( grid.leafGridView().size( 0 ) );
+        } );
+
+      report.runOnce( comm, name, "loadBalance", [ &grid ] () {
+          grid.loadBalance();
+          return std::size_t( grid.leafGridView().size( 0 ) );
+        } );
+    }
+
+
+
+    // writeReport
+    // -----------
+
+    template< class Comm >
+    inline void writeReport ( const Report &report, const ParameterTree &params, const Comm &comm,
+                              const std::string &defaultName = "dune-grid-benchmarks.json" )
+    {
+      if( comm.rank() != 0 )
+        return;
+      const std::string fileName = params.get< std::string >( "output", defaultName );
+      std::ofstream out( fileName );
+      report.writeJson( out, params, comm.size() );
+    }
+
+  } // namespace Benchmark
+
+} // namespace Dune
+
+#endif // #ifndef DUNE_GRID_BENCHMARKS_BENCHMARK_HH
@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+/* Performance benchmarks of AlbertaGrid, see dune-grid-benchmark.cc for the options.
+ * AlbertaGrid needs its world dimension at compile time, so it gets its own program.
+ */
+
+#include <iostream>
+#include <string>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/parametertree.hh>
+#include <dune/common/parametertreeparser.hh>
+
+#include <dune/grid/albertagrid.hh>
+#include <dune/grid/utility/structuredgridfactory.hh>
+
+#include "benchmark.hh"
+
+int main ( int argc, char **argv )
+try
+{
+  const auto &mpiHelper = Dune::MPIHelper::instance( argc, argv );
+
+  Dune::ParameterTree params;
+  Dune::ParameterTreeParser::readOptions( argc, argv, params );
+  const unsigned int cells = params.get( "cells", 128 );
+
+  Dune::Benchmark::Report report( params );
+
+  if( report.enabled( "alberta" ) )
+  {
+    typedef Dune::AlbertaGrid< 2, 2 > Grid;
+    auto grid = Dune::StructuredGridFactory< Grid >::createSimplexGrid( { 0.0, 0.0 }, { 1.0, 1.0 }, {{ cells, cells }} );
+    Dune::Benchmark::benchmarkGrid( report, "alberta", *grid, params, true );
+  }
+
+  Dune::Benchmark::writeReport( report, params, mpiHelper.getCommunication(), "dune-grid-benchmarks-alberta.json" );
+  return 0;
+}
+catch( const Dune::Exception &e )
+{
+  std::cerr << e << std::endl;
+  return 1;
+}
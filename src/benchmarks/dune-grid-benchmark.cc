@@ -0,0 +1,151 @@
+// SPDX-FileCopyrightText: Copyright © DUNE Project contributors, see file LICENSE.md in module root
+// SPDX-License-Identifier: LicenseRef-GPL-2.0-only-with-DUNE-exception
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+/* Performance benchmarks of the grid managers shipped with dune-grid.
+ *
+ * Usage: dune-grid-benchmark [-cells N] [-repeat R] [-commsize S] [-grids yasp,oned,...]
+ *                            [-output file.json] [-prefix name] [-verbose 0|1]
+ *
+ * Each grid is built with N cells per direction and the iteration, geometry, index,
+ * id, mapper, communication and output benchmarks are run on its leaf grid view,
+ * followed by one global refinement and a load balancing step. The timings are
+ * written to a JSON file so that runs can be compared across revisions.
+ */
+
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/parametertree.hh>
+#include <dune/common/parametertreeparser.hh>
+
+#include <dune/grid/geometrygrid.hh>
+#include <dune/grid/identitygrid.hh>
+#include <dune/grid/onedgrid.hh>
+#include <dune/grid/yaspgrid.hh>
+#if HAVE_DUNE_UGGRID
+#include <dune/grid/uggrid.hh>
+#include <dune/grid/utility/structuredgridfactory.hh>
+#endif // #if HAVE_DUNE_UGGRID
+
+#include "benchmark.hh"
+
+// a smooth deformation of the unit square, used for the GeometryGrid benchmarks
+class Deformation
+  : public Dune::AnalyticalCoordFunction< double, 2, 2, Deformation >
+{
+  typedef Dune::AnalyticalCoordFunction< double, 2, 2, Deformation > Base;
+
+public:
+  typedef Base::DomainVector DomainVector;
+  typedef Base::RangeVector RangeVector;
+
+  void evaluate ( const DomainVector &x, RangeVector &y ) const
+  {
+    y[ 0 ] = x[ 0 ] + 0.1 * std::sin( 2.0 * M_PI * x[ 1 ] );
+    y[ 1 ] = x[ 1 ] + 0.1 * std::sin( 2.0 * M_PI * x[ 0 ] );
+  }
+};
+
+typedef Dune::YaspGrid< 2 > Yasp;
+
+std::unique_ptr< Yasp > createYasp ( int cells )
+{
+  return std::make_unique< Yasp >( Dune::FieldVector< double, 2 >( 1.0 ), std::array< int, 2 >{{ cells, cells }} );
+}
+
+int main ( int argc, char **argv )
+try
+{
+  const auto &mpiHelper = Dune::MPIHelper::instance( argc, argv );
+
+  Dune::ParameterTree params;
+  Dune::ParameterTreeParser::readOptions( argc, argv, params );
+  const int cells = params.get( "cells", 128 );
+
+  Dune::Benchmark::Report report( params );
+
+  if( report.enabled( "yasp" ) )
+  {
+    auto grid = createYasp( cells );
+    Dune::Benchmark::benchmarkGrid( report, "yasp", *grid, params );
+  }
+
+  if( report.enabled( "oned" ) )
+  {
+    Dune::OneDGrid grid( cells*cells, 0.0, 1.0 );
+    Dune::Benchmark::benchmarkGrid( report, "oned", grid, params, true );
+  }
+
+#if HAVE_DUNE_UGGRID
+  if( report.enabled( "ug" ) )
+  {
+    typedef Dune::UGGrid< 2 > Grid;
+    auto grid = Dune::StructuredGridFactory< Grid >::createSimplexGrid( { 0.0, 0.0 }, { 1.0, 1.0 }, {{ unsigned( cells ), unsigned( cells ) }} );
+    grid->loadBalance();
+    Dune::Benchmark::benchmarkGrid( report, "ug", *grid, params, true );
+  }
+#endif // #if HAVE_DUNE_UGGRID
+
+  if( report.enabled( "geometry" ) )
+  {
+    auto host = createYasp( cells );
+    Deformation deformation;
+    Dune::GeometryGrid< Yasp, Deformation > grid( *host, deformation );
+    Dune::Benchmark::benchmarkGrid( report, "geometry", grid, params );
+  }
+
+  // cost of the meta grid layers on top of the same host grid
+  if( report.enabled( "identity" ) )
+  {
+    auto host = createYasp( cells );
+    Dune::IdentityGrid< Yasp > grid( *host );
+    Dune::Benchmark::benchmarkGrid( report, "identity", grid, params );
+  }
+
+  if( report.enabled( "identity2" ) )
+  {
+    auto host = createYasp( cells );
+    Dune::IdentityGrid< Yasp > inner( *host );
+    Dune::IdentityGrid< Dune::IdentityGrid< Yasp > > grid( inner );
+    Dune::Benchmark::benchmarkGrid( report, "identity2", grid, params );
+  }
+
+  if( report.enabled( "identity3" ) )
+  {
+    auto host = createYasp( cells );
+    Dune::IdentityGrid< Yasp > inner( *host );
+    Dune::IdentityGrid< Dune::IdentityGrid< Yasp > > middle( inner );
+    Dune::IdentityGrid< Dune::IdentityGrid< Dune::IdentityGrid< Yasp > > > grid( middle );
+    Dune::Benchmark::benchmarkGrid( report, "identity3", grid, params );
+  }
+
+  if( report.enabled( "identity-geometry" ) )
+  {
+    typedef Dune::GeometryGrid< Yasp, Deformation > HostGrid;
+    auto host = createYasp( cells );
+    Deformation deformation;
+    HostGrid inner( *host, deformation );
+    Dune::IdentityGrid< HostGrid > grid( inner );
+    Dune::Benchmark::benchmarkGrid( report, "identity-geometry", grid, params );
+  }
+
+  Dune::Benchmark::writeReport( report, params, mpiHelper.getCommunication() );
+  return 0;
+}
+catch( const Dune::Exception &e )
+{
+  std::cerr << e << std::endl;
+  return 1;
+}